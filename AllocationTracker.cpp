@@ -0,0 +1,136 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+
+/**
+ * @brief Heap counters of one thread, trivial types -> usable in operator new before and after thread storage setup
+ */
+struct ThreadAllocations {
+    size_t allocations = 0;    ///< Number of calls of operator new
+    size_t deallocations = 0;  ///< Number of calls of operator delete
+    size_t bytes = 0;          ///< Number of allocated bytes
+    std::int64_t live = 0;     ///< Allocated minus freed bytes, negative if thread frees memory of other threads
+    std::int64_t peak = 0;     ///< Maximum of live bytes since the innermost scope started
+};
+
+static thread_local ThreadAllocations threadAllocations;
+
+
+#ifdef CHECKMATE_ALLOC_STATS
+static const size_t ALLOCATION_HEADER = alignof(std::max_align_t);  ///< Bytes before block storing its size
+
+
+/**
+ * @brief Allocate block with header storing its size and count it
+ * @param size requested size
+ * @return allocated block, nullptr on failure
+ */
+static void *countedAllocate(size_t size) {
+    void *block = std::malloc(size + ALLOCATION_HEADER);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *static_cast<size_t *>(block) = size;
+
+    ThreadAllocations &counters = threadAllocations;
+    ++counters.allocations;
+    counters.bytes += size;
+    counters.live += static_cast<std::int64_t>(size);
+    counters.peak = std::max(counters.peak, counters.live);
+    return static_cast<char *>(block) + ALLOCATION_HEADER;
+}
+
+
+/**
+ * @brief Free block allocated by countedAllocate and count it
+ * @param pointer allocated block, may be nullptr
+ */
+static void countedFree(void *pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    void *block = static_cast<char *>(pointer) - ALLOCATION_HEADER;
+
+    ThreadAllocations &counters = threadAllocations;
+    ++counters.deallocations;
+    counters.live -= static_cast<std::int64_t>(*static_cast<size_t *>(block));
+    std::free(block);
+}
+
+
+// replaced global operators, nothrow, sized and array versions of the standard library call these ones; aligned
+// versions keep the default implementation and are not counted
+void *operator new(size_t size) {
+    void *pointer = countedAllocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+
+void operator delete(void *pointer) noexcept {
+    countedFree(pointer);
+}
+
+
+void operator delete[](void *pointer) noexcept {
+    countedFree(pointer);
+}
+
+
+void operator delete(void *pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+
+
+void operator delete[](void *pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+#endif
+
+
+/**
+ * @brief Constructor, starts counting
+ */
+AllocationScope::AllocationScope() {
+    ThreadAllocations &counters = threadAllocations;
+    start_.allocations = counters.allocations;
+    start_.deallocations = counters.deallocations;
+    start_.bytes = counters.bytes;
+    startLive_ = counters.live;
+    outerPeak_ = counters.peak;
+    counters.peak = counters.live;
+}
+
+
+/**
+ * @brief Destructor, restores peak of enclosing scope
+ */
+AllocationScope::~AllocationScope() {
+    ThreadAllocations &counters = threadAllocations;
+    counters.peak = std::max(outerPeak_, counters.peak);
+}
+
+
+/**
+ * @brief Get allocations since construction
+ * @return allocation statistics of scope
+ */
+AllocationStats AllocationScope::stats() const {
+    const ThreadAllocations &counters = threadAllocations;
+    AllocationStats stats;
+    stats.allocations = counters.allocations - start_.allocations;
+    stats.deallocations = counters.deallocations - start_.deallocations;
+    stats.bytes = counters.bytes - start_.bytes;
+    stats.peakBytes = static_cast<size_t>(std::max<std::int64_t>(0, counters.peak - startLive_));
+    return stats;
+}
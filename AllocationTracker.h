@@ -0,0 +1,62 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// counting replaces global operator new and delete, so it is compiled only with CHECKMATE_ALLOC_STATS
+#ifdef CHECKMATE_ALLOC_STATS
+static const bool ALLOCATION_STATS_ENABLED = true;   ///< Allocations are counted
+#else
+static const bool ALLOCATION_STATS_ENABLED = false;  ///< Allocation counting is not compiled in
+#endif
+
+
+/**
+ * @brief Struct holding heap allocations of one thread during one scope (e.g. findCheckMate call).
+ */
+struct AllocationStats {
+    size_t allocations = 0;    ///< Number of calls of operator new
+    size_t deallocations = 0;  ///< Number of calls of operator delete
+    size_t bytes = 0;          ///< Number of allocated bytes
+    size_t peakBytes = 0;      ///< Maximum of bytes allocated in scope and not yet freed
+};
+
+
+/**
+ * @brief Counters of heap allocations of calling thread between construction and stats() call.
+ * @details Counters are thread-local, so searches in other threads are not counted. Scopes may be nested, peak of
+ * inner scope is included in peak of outer scope. Without CHECKMATE_ALLOC_STATS all stats are zero.
+ */
+class AllocationScope {
+private:
+    AllocationStats start_;     ///< Counters of thread when scope started
+    std::int64_t startLive_;    ///< Live bytes of thread when scope started
+    std::int64_t outerPeak_;    ///< Peak of live bytes of enclosing scope when scope started
+
+public:
+    /**
+     * @brief Constructor, starts counting
+     */
+    AllocationScope();
+
+
+    /**
+     * @brief Destructor, restores peak of enclosing scope
+     */
+    ~AllocationScope();
+
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+
+    /**
+     * @brief Get allocations since construction
+     * @return allocation statistics of scope
+     */
+    AllocationStats stats() const;
+};
+
+
+#endif //ALLOCATIONTRACKER_H
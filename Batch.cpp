@@ -0,0 +1,224 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include "Chess.h"
+#include "Puzzle.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+// batch solver of puzzle files in inputs/FEN format, see USAGE.md for more info
+
+
+/**
+ * @brief Batch settings given on command line
+ */
+struct BatchSettings {
+    size_t threadCount = 0;                ///< Number of worker threads, 0 = hardware threads
+    size_t maxDepth = SIZE_MAX;            ///< Puzzles with deeper checkmate are skipped
+    size_t pruningSize = PRUNING_SIZE;     ///< Number of moves to consider, results are verified
+    bool allSolutions = false;             ///< Find all mating first moves and count mating lines
+    std::string cachePath;                 ///< Solution cache file, empty = no cache
+    std::string tablebasePath;             ///< Directory of endgame tables, empty = no tables
+    std::string tracePath;                 ///< Chrome trace file of search phases, empty = no tracing
+    std::vector<std::string> paths;        ///< Puzzle files and directories
+};
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-j threads] [--max-depth N] [--pruning N] [--all] [--cache file] "
+              << "[--tablebases directory] [--trace file] <file or directory>..." << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return settings, empty if arguments are invalid
+ */
+static std::optional<BatchSettings> parseArguments(int argc, char *argv[]) {
+    BatchSettings settings;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "-j" && hasValue) {
+                settings.threadCount = std::stoul(argv[++i]);
+            }
+            else if (argument == "--max-depth" && hasValue) {
+                settings.maxDepth = std::stoul(argv[++i]);
+            }
+            else if (argument == "--pruning" && hasValue) {
+                settings.pruningSize = std::stoul(argv[++i]);
+            }
+            else if (argument == "--cache" && hasValue) {
+                settings.cachePath = argv[++i];
+            }
+            else if (argument == "--tablebases" && hasValue) {
+                settings.tablebasePath = argv[++i];
+            }
+            else if (argument == "--trace" && hasValue) {
+                settings.tracePath = argv[++i];
+            }
+            else if (argument == "--all") {
+                settings.allSolutions = true;
+            }
+            else if (!argument.empty() && argument[0] == '-') {
+                return std::nullopt;
+            }
+            else {
+                settings.paths.push_back(argument);
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    if (settings.paths.empty() || settings.pruningSize == 0) {
+        return std::nullopt;
+    }
+    return settings;
+}
+
+
+/**
+ * @brief Find all solutions of loaded puzzle and write them to result line
+ * @param chess chess with loaded puzzle
+ * @param puzzle loaded puzzle
+ * @param result result line to write to: result (unique, multiple or no-checkmate), mating first moves, number of
+ * mating lines and time in milliseconds
+ */
+static void solveAllSolutions(Chess &chess, const Puzzle &puzzle, std::ostringstream &result) {
+    auto start = std::chrono::steady_clock::now();
+    MateSolutions solutions = chess.findAllCheckMates(puzzle.colorOnMove, puzzle.searchDepth);
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+    if (solutions.firstMoves.empty()) {
+        result << "no-checkmate";
+    }
+    else {
+        result << (solutions.isUnique() ? "unique" : "multiple");
+    }
+    result << '\t';
+    for (size_t i = 0; i < solutions.firstMoves.size(); ++i) {
+        result << (i == 0 ? "" : " ") << chess.moveNotation(solutions.firstMoves[i]);
+    }
+    result << '\t' << solutions.lineCount << '\t' << std::fixed << std::setprecision(3) << time.count();
+}
+
+
+/**
+ * @brief Solve one puzzle file
+ * @param chess chess owned by worker thread
+ * @param fileName name of puzzle file
+ * @param settings batch settings
+ * @return result line: file, result, best move, time in milliseconds and principal variation separated by tabs
+ */
+static std::string solvePuzzle(Chess &chess, const std::string &fileName, const BatchSettings &settings) {
+    std::ostringstream result;
+    result << fileName << '\t';
+
+    try {
+        Puzzle puzzle = Puzzle::load(fileName);
+        if (puzzle.searchDepth > settings.maxDepth) {
+            result << "skipped";
+            return result.str();
+        }
+
+        chess.clearGame();
+        chess.loadFENGame(puzzle.FENCode);
+        if (settings.allSolutions) {
+            solveAllSolutions(chess, puzzle, result);
+            return result.str();
+        }
+
+        SearchResult searchResult = chess.findCheckMate(puzzle.colorOnMove, puzzle.searchDepth, false,
+                                                        PruningPolicy::symmetric(settings.pruningSize, true));
+
+        result << (searchResult ? "checkmate" : "no-checkmate") << '\t' << searchResult.bestMove << '\t'
+               << std::fixed << std::setprecision(3) << searchResult.time << '\t';
+        std::vector<std::string> line = chess.lineNotation(searchResult.principalVariation);
+        for (size_t i = 0; i < line.size(); ++i) {
+            result << (i == 0 ? "" : " ") << line[i];
+        }
+    }
+    catch (const std::exception &e) {
+        result << "error\t" << e.what();
+    }
+    return result.str();
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<BatchSettings> settings = parseArguments(argc, argv);
+    if (!settings) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> files = Puzzle::listFiles(settings->paths);
+    std::vector<std::optional<std::string>> results(files.size());
+    size_t nextResult = 0;
+    std::mutex resultsMutex;
+
+    // one chess per worker -> no locking during search
+    ThreadPool pool(settings->threadCount);
+    std::vector<Chess> games(pool.size());
+
+    // cache is shared by workers and by other processes using the same file, tables are shared read-only mappings
+    std::unique_ptr<SolutionCache> cache;
+    std::unique_ptr<Tablebases> tablebases;
+    std::ofstream traceFile;
+    try {
+        cache = settings->cachePath.empty() ? nullptr : std::make_unique<SolutionCache>(settings->cachePath);
+        tablebases = settings->tablebasePath.empty() ? nullptr : std::make_unique<Tablebases>(settings->tablebasePath);
+        if (!settings->tracePath.empty()) {
+            traceFile.open(settings->tracePath);
+            if (!traceFile) {
+                throw std::runtime_error("Failed to open file " + settings->tracePath);
+            }
+            Trace::enable();
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    for (Chess &chess : games) {
+        chess.setSolutionCache(cache.get());
+        chess.setTablebases(tablebases.get());
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        pool.submit([&, i](size_t worker) {
+            std::string result = solvePuzzle(games[worker], files[i], *settings);
+
+            // print results in input order as soon as all previous results are known
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            results[i] = std::move(result);
+            while (nextResult < results.size() && results[nextResult]) {
+                std::cout << *results[nextResult] << '\n';
+                results[nextResult++].reset();
+            }
+            std::cout.flush();
+        });
+    }
+    pool.wait();
+
+    // workers are idle -> their traces can be read
+    if (Trace::isEnabled()) {
+        Trace::disable();
+        Trace::writeChromeTrace(traceFile);
+        Trace::printProfile(std::cerr);
+    }
+    return 0;
+}
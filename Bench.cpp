@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include "Chess.h"
+#include "Json.h"
+#include "PerfCounters.h"
+#include "Puzzle.h"
+
+// benchmark of puzzle files in inputs/FEN format, writes one JSON object per puzzle and summary, see USAGE.md for
+// more info
+
+#ifndef CHECKMATE_BUILD_TYPE
+#define CHECKMATE_BUILD_TYPE ""
+#endif
+
+
+/**
+ * @brief Benchmark settings given on command line
+ */
+struct BenchSettings {
+    size_t repeat = 1;                  ///< Number of searches of each puzzle, the fastest one is reported
+    size_t maxDepth = SIZE_MAX;         ///< Puzzles with deeper checkmate are skipped
+    size_t maxNodes = 0;                ///< Node budget of each search, 0 = unlimited
+    size_t pruningSize = PRUNING_SIZE;  ///< Number of moves to consider, results are verified
+    std::string tablebasePath;          ///< Directory of endgame tables, empty = no tables
+    std::vector<std::string> paths;     ///< Puzzle files and directories
+};
+
+
+/**
+ * @brief Totals over all benchmarked puzzles
+ */
+struct BenchTotals {
+    size_t puzzles = 0;           ///< Number of benchmarked puzzles
+    size_t solved = 0;            ///< Number of puzzles with checkmate found in listed number of moves
+    size_t errors = 0;            ///< Number of puzzles which could not be loaded
+    size_t searched = 0;          ///< Number of puzzles whose searches are included in counters
+    size_t nodes = 0;             ///< Number of visited nodes
+    double time = 0;              ///< Search time in milliseconds
+    PerfSample counters;          ///< Hardware events of all searches, events not counted in some search are empty
+    AllocationStats allocations;  ///< Heap allocations of all searches, peak is maximum of peaks
+};
+
+
+/**
+ * @brief Add hardware events of searches and their averages per node
+ * @param writer JSON object to add to
+ * @param sample hardware events of searches
+ * @param nodes number of searched nodes
+ */
+static void addCounters(JsonWriter &writer, const PerfSample &sample, size_t nodes) {
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        PerfEvent event = static_cast<PerfEvent>(i);
+        std::string name = PerfCounters::eventName(event);
+        std::optional<double> perNode = sample.perNode(event, nodes);
+        if (sample.counts[i]) {
+            writer.add(name, *sample.counts[i]);
+        }
+        else {
+            writer.addRaw(name, "null");
+        }
+        if (perNode) {
+            writer.add(name + "PerNode", *perNode);
+        }
+        else {
+            writer.addRaw(name + "PerNode", "null");
+        }
+    }
+    std::optional<double> instructionsPerCycle = sample.instructionsPerCycle();
+    if (instructionsPerCycle) {
+        writer.add("ipc", *instructionsPerCycle);
+    }
+    else {
+        writer.addRaw("ipc", "null");
+    }
+}
+
+
+/**
+ * @brief Add heap allocations of searches, null unless built with CHECKMATE_ALLOC_STATS
+ * @param writer JSON object to add to
+ * @param stats heap allocations of searches
+ * @param nodes number of searched nodes
+ */
+static void addAllocations(JsonWriter &writer, const AllocationStats &stats, size_t nodes) {
+    if (!ALLOCATION_STATS_ENABLED) {
+        writer.addRaw("allocations", "null").addRaw("allocationsPerNode", "null").addRaw("allocatedBytes", "null")
+              .addRaw("peakBytes", "null");
+        return;
+    }
+    writer.add("allocations", stats.allocations)
+          .add("allocationsPerNode", nodes > 0 ? static_cast<double>(stats.allocations) / nodes : 0)
+          .add("allocatedBytes", stats.bytes).add("peakBytes", stats.peakBytes);
+}
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-r repeat] [--max-depth N] [--max-nodes N] [--pruning N] "
+              << "[--tablebases directory] "
+              << "<file or directory>..." << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return settings, empty if arguments are invalid
+ */
+static std::optional<BenchSettings> parseArguments(int argc, char *argv[]) {
+    BenchSettings settings;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "-r" && hasValue) {
+                settings.repeat = std::max<size_t>(1, std::stoul(argv[++i]));
+            }
+            else if (argument == "--max-depth" && hasValue) {
+                settings.maxDepth = std::stoul(argv[++i]);
+            }
+            else if (argument == "--max-nodes" && hasValue) {
+                settings.maxNodes = std::stoul(argv[++i]);
+            }
+            else if (argument == "--pruning" && hasValue) {
+                settings.pruningSize = std::stoul(argv[++i]);
+            }
+            else if (argument == "--tablebases" && hasValue) {
+                settings.tablebasePath = argv[++i];
+            }
+            else if (!argument.empty() && argument[0] == '-') {
+                return std::nullopt;
+            }
+            else {
+                settings.paths.push_back(argument);
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    if (settings.paths.empty() || settings.pruningSize == 0) {
+        return std::nullopt;
+    }
+    return settings;
+}
+
+
+/**
+ * @brief Benchmark one puzzle file, the puzzle is searched repeat times and the fastest search is reported
+ * @param chess chess reused by all puzzles
+ * @param counters hardware counters read around each search
+ * @param fileName name of puzzle file
+ * @param settings benchmark settings
+ * @param totals totals updated by benchmarked puzzle
+ * @return one-line JSON object, empty if puzzle is skipped
+ */
+static std::optional<std::string> benchPuzzle(Chess &chess, PerfCounters &counters, const std::string &fileName,
+                                              const BenchSettings &settings, BenchTotals &totals) {
+    JsonWriter writer;
+    writer.add("file", fileName);
+
+    try {
+        Puzzle puzzle = Puzzle::load(fileName);
+        if (puzzle.searchDepth > settings.maxDepth) {
+            return std::nullopt;
+        }
+
+        SearchResult best;
+        PerfSample bestCounters;
+        for (size_t i = 0; i < settings.repeat; ++i) {
+            chess.clearGame();
+            chess.clearMoveOrdering();
+            chess.loadFENGame(puzzle.FENCode);
+            counters.start();
+            SearchResult result = chess.findCheckMate(puzzle.colorOnMove, puzzle.searchDepth, false,
+                                                      PruningPolicy::symmetric(settings.pruningSize, true));
+            PerfSample sample = counters.stop();
+            if (i == 0 || result.time < best.time) {
+                best = result;
+                bestCounters = sample;
+            }
+        }
+
+        // move ordering is cleared before each search -> repeated searches differ only in time
+        double nodesPerSecond = best.time > 0 ? best.stats.nodes / (best.time / 1000) : 0;
+        bool solved = best.checkMate && best.mateDistance <= puzzle.searchDepth;
+        ++totals.puzzles;
+        totals.solved += solved ? 1 : 0;
+        totals.nodes += best.stats.nodes;
+        totals.time += best.time;
+        totals.allocations.allocations += best.stats.allocations.allocations;
+        totals.allocations.deallocations += best.stats.allocations.deallocations;
+        totals.allocations.bytes += best.stats.allocations.bytes;
+        totals.allocations.peakBytes = std::max(totals.allocations.peakBytes, best.stats.allocations.peakBytes);
+        for (size_t event = 0; event < PERF_EVENT_COUNT; ++event) {
+            std::optional<std::uint64_t> &total = totals.counters.counts[event];
+            const std::optional<std::uint64_t> &count = bestCounters.counts[event];
+            total = (count && (total || totals.searched == 0)) ? std::optional(total.value_or(0) + *count) : std::nullopt;
+        }
+        ++totals.searched;
+
+        writer.add("depth", puzzle.searchDepth).add("solved", solved);
+        if (best.checkMate) {
+            writer.add("mateIn", best.mateDistance);
+        }
+        else {
+            writer.addRaw("mateIn", "null");
+        }
+        std::string move = chess.moveNotation(best.bestMove);
+        if (move.empty()) {
+            writer.addRaw("move", "null");
+        }
+        else {
+            writer.add("move", move);
+        }
+        writer.add("time", best.time).add("nodes", best.stats.nodes)
+              .add("nodesPerSecond", static_cast<size_t>(nodesPerSecond))
+              .add("tablebaseHits", best.stats.tablebaseHits).add("status", searchStatusName(best.status));
+        addCounters(writer, bestCounters, best.stats.nodes);
+        addAllocations(writer, best.stats.allocations, best.stats.nodes);
+    }
+    catch (const std::exception &e) {
+        ++totals.puzzles;
+        ++totals.errors;
+        writer.add("error", e.what());
+    }
+    return writer.str();
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<BenchSettings> settings = parseArguments(argc, argv);
+    if (!settings) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // puzzles are searched one by one in one thread, so numbers do not depend on scheduling, node budget is
+    // deterministic unlike time limit
+    Chess chess;
+    SearchLimits limits;
+    limits.maxNodes = settings->maxNodes;
+    chess.setSearchLimits(limits);
+    std::unique_ptr<Tablebases> tablebases;
+    try {
+        tablebases = settings->tablebasePath.empty() ? nullptr : std::make_unique<Tablebases>(settings->tablebasePath);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    chess.setTablebases(tablebases.get());
+
+    // counters are optional (no PMU in containers), events which cannot be counted are reported as null
+    PerfCounters counters;
+    if (!counters.error().empty()) {
+        std::cerr << counters.error() << std::endl;
+    }
+
+    BenchTotals totals;
+    for (const std::string &fileName : Puzzle::listFiles(settings->paths)) {
+        std::optional<std::string> line = benchPuzzle(chess, counters, fileName, *settings, totals);
+        if (line) {
+            std::cout << *line << std::endl;
+        }
+    }
+
+    double nodesPerSecond = totals.time > 0 ? totals.nodes / (totals.time / 1000) : 0;
+    JsonWriter summary;
+    summary.add("summary", true).add("build", CHECKMATE_BUILD_TYPE).add("puzzles", totals.puzzles)
+           .add("solved", totals.solved).add("errors", totals.errors).add("time", totals.time)
+           .add("nodes", totals.nodes).add("nodesPerSecond", static_cast<size_t>(nodesPerSecond))
+           .add("perfCounters", counters.available());
+    addCounters(summary, totals.counters, totals.nodes);
+    addAllocations(summary, totals.allocations, totals.nodes);
+    std::cout << summary.str() << std::endl;
+    return totals.errors == 0 ? 0 : 1;
+}
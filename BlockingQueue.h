@@ -0,0 +1,68 @@
+#ifndef BLOCKINGQUEUE_H
+#define BLOCKINGQUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <queue>
+
+
+/**
+ * @brief Unbounded queue connecting pipeline stages running in different threads.
+ * @details Consumer blocks until item is available or queue is closed. After close, remaining items are still
+ * returned and then pop returns empty optional.
+ */
+template<typename T>
+class BlockingQueue {
+public:
+    /**
+     * @brief Add item to the queue
+     * @param item item to add
+     */
+    void push(T item) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push(std::move(item));
+        }
+        itemAvailable_.notify_one();
+    }
+
+
+    /**
+     * @brief Remove first item, blocks until item is available or queue is closed
+     * @return first item, empty if queue is closed and empty
+     */
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        itemAvailable_.wait(lock, [this] { return closed_ || !items_.empty(); });
+
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(items_.front());
+        items_.pop();
+        return item;
+    }
+
+
+    /**
+     * @brief Close the queue, no more items will be pushed
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        itemAvailable_.notify_all();
+    }
+
+
+private:
+    std::queue<T> items_;                     ///< Items waiting for consumer
+    std::mutex mutex_;                        ///< Guards items_ and closed_
+    std::condition_variable itemAvailable_;   ///< Signals new item or closing
+    bool closed_ = false;                     ///< No more items will be pushed
+};
+
+
+#endif //BLOCKINGQUEUE_H
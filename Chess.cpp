@@ -1,5 +1,8 @@
 #include "Chess.h"
+#include "Trace.h"
+#include "Zobrist.h"
 
+#include <chrono>
 #include <ranges>
 
 /**
@@ -9,7 +12,7 @@
  * @param positions empty vector of positions to fill by positions which might be check-blocking
  * @return true if piece blocks check
  */
-bool Chess::pieceBlocksCheck(const Position &piecePosition, Color kingColor, std::vector<Position> &positions) const {
+bool Chess::pieceBlocksCheck(const Position &piecePosition, Color kingColor, position_list &positions) const {
     // get vector defined by my piece and my king
     Position kingPosition = this->myKingPosition(kingColor);
     Vector2D vector = piecePosition - kingPosition;
@@ -34,10 +37,9 @@ bool Chess::pieceBlocksCheck(const Position &piecePosition, Color kingColor, std
     positions.push_back(newPosition);
     while (onChessboard(newPosition)) {
         if (!isFree(newPosition)) {
-            if (isEnemy(newPosition, kingColor)) {
-                piece_ptr piece = chessBoard_[newPosition.x_][newPosition.y_];
-                return piece->isCheckBlockAble() && piece->canMoveDirection(vector);
-            }
+            // another piece of king color behind the piece blocks the line too
+            Piece piece = chessBoard_[newPosition.x_][newPosition.y_];
+            return isEnemy(newPosition, kingColor) && piece.isCheckBlockAble() && piece.canMoveDirection(vector);
         }
         newPosition += vector;
         positions.push_back(newPosition);
@@ -55,7 +57,7 @@ bool Chess::pieceBlocksCheck(const Position &piecePosition, Color kingColor, std
 bool Chess::kingsNeighboursOrCheck(const Position &newPosition, Color myColor) {
     // get king position
     Position myKingPosition = this->myKingPosition(myColor);
-    piece_ptr backup = chessBoard_[newPosition.x_][newPosition.y_];
+    Piece backup = chessBoard_[newPosition.x_][newPosition.y_];
 
     // temporary updatePosition king
     movePiece(std::make_pair(myKingPosition, newPosition));
@@ -70,7 +72,8 @@ bool Chess::kingsNeighboursOrCheck(const Position &newPosition, Color myColor) {
 
 
 bool Chess::kingHasCheck(Color myColor) {
-    int checkCount;
+    TRACE_SCOPE("checkDetection");
+    int checkCount = 0;
     Position checkingPiece;
 
     return isCheckedByKnight(myColor, checkingPiece) || isCheckedByPawn(myColor, checkingPiece) ||
@@ -157,6 +160,54 @@ void Chess::loadFENGame(const std::string &FENCode) {
 }
 
 
+/**
+ * @brief Get piece placement of current position in FEN format, it can be loaded by loadFENGame
+ * @return FEN code of game
+ */
+std::string Chess::getFENCode() const {
+    std::string FENCode;
+
+    for (int x = 0; x < 8; ++x) {
+        int emptySquares = 0;
+        for (int y = 0; y < 8; ++y) {
+            Piece piece = chessBoard_[x][y];
+            if (piece.isEmpty()) {
+                ++emptySquares;
+                continue;
+            }
+            FENCode += (emptySquares > 0) ? std::to_string(emptySquares) : "";
+            emptySquares = 0;
+
+            char letter;
+            switch (piece.getPieceType()) {
+                case PieceType::PAWN:
+                    letter = 'P';
+                    break;
+                case PieceType::KNIGHT:
+                    letter = 'N';
+                    break;
+                case PieceType::BISHOP:
+                    letter = 'B';
+                    break;
+                case PieceType::ROOK:
+                    letter = 'R';
+                    break;
+                case PieceType::QUEEN:
+                    letter = 'Q';
+                    break;
+                default:
+                    letter = 'K';
+                    break;
+            }
+            FENCode += (piece.getColor() == Color::WHITE) ? letter : static_cast<char>(std::tolower(letter));
+        }
+        FENCode += (emptySquares > 0) ? std::to_string(emptySquares) : "";
+        FENCode += (x < 7) ? "/" : "";
+    }
+    return FENCode;
+}
+
+
 /**
  * @brief load color of piece
  * @param color string color of piece
@@ -205,28 +256,23 @@ void Chess::createPiece(const Position &position, Color color, const std::string
 
     // create piece
     if (pieceType == "king" || pieceType == "K") {
-        chessBoard_[x][y] = std::make_shared<King>(color, position);
-        (color == Color::WHITE) ? whiteKing_ = chessBoard_[x][y] : blackKing_ = chessBoard_[x][y];
+        chessBoard_[x][y] = Piece(color, PieceType::KING);
+        (color == Color::WHITE) ? whiteKingPosition_ = position : blackKingPosition_ = position;
     }
     else if (pieceType == "queen" || pieceType == "Q") {
-        chessBoard_[x][y] = std::make_shared<Queen>(color, position);
+        chessBoard_[x][y] = Piece(color, PieceType::QUEEN);
     }
     else if (pieceType == "rook" || pieceType == "R") {
-        chessBoard_[x][y] = std::make_shared<Rook>(color, position);
+        chessBoard_[x][y] = Piece(color, PieceType::ROOK);
     }
     else if (pieceType == "bishop" || pieceType == "B") {
-        chessBoard_[x][y] = std::make_shared<Bishop>(color, position);
+        chessBoard_[x][y] = Piece(color, PieceType::BISHOP);
     }
     else if (pieceType == "knight" || pieceType == "N") {
-        chessBoard_[x][y] = std::make_shared<Knight>(color, position);
+        chessBoard_[x][y] = Piece(color, PieceType::KNIGHT);
     }
     else if (pieceType == "pawn" || pieceType == "P") {
-        if (color == Color::WHITE) {
-            chessBoard_[x][y] = std::make_shared<PawnWhite>(position);
-        }
-        else {
-            chessBoard_[x][y] = std::make_shared<PawnBlack>(position);
-        }
+        chessBoard_[x][y] = Piece(color, PieceType::PAWN);
     }
     else {
         throw InvalidPieceType();
@@ -234,14 +280,42 @@ void Chess::createPiece(const Position &position, Color color, const std::string
 }
 
 
+/**
+ * @brief Remove all pieces from the chessboard, so another game can be loaded.
+ */
+void Chess::clearGame() {
+    for (auto &row : chessBoard_) {
+        for (auto &piece : row) {
+            piece = Piece();
+        }
+    }
+    whiteKingPosition_ = Position();
+    blackKingPosition_ = Position();
+    minimaxMoves_.clear();
+    checkMateList_.clear();
+}
+
+
+/**
+ * @brief Forget counter moves and refutations learned by previous searches, so the next search visits the same nodes
+ * as the first search of new Chess
+ */
+void Chess::clearMoveOrdering() {
+    for (auto &row : counterMoves_) {
+        std::fill(std::begin(row), std::end(row), piece_move());
+    }
+    refutations_.clear();
+}
+
+
 /**
  * @brief Check if both kings exist on the chessboard.
  */
 void Chess::validateKings() {
-    if (whiteKing_ == nullptr) {
+    if (!onChessboard(whiteKingPosition_)) {
         throw WhiteKingDoesNotExist();
     }
-    else if (blackKing_ == nullptr) {
+    else if (!onChessboard(blackKingPosition_)) {
         throw BlackKingDoesNotExist();
     }
     else if (kingsAreNeighbours()) {
@@ -254,22 +328,166 @@ void Chess::validateKings() {
   * @brief Check if color can give checkmate in searchDepth moves
   * @param colorOnMove color of player on move
   * @param searchDepth search depth
-  * @param addCheckMateMoves whether to trace checkmate moves in checkMateList_
+  * @param addCheckMateMoves whether to add mating line to checkMateList_
   * @param pruningSize number of best moves to consider
-  * @return true if colorOnMove can give checkmate in searchDepth moves
+  * @param verifyPruning if true, pruned results are verified by re-search and widened until they are sound
+  * @return result of search, converts to true if colorOnMove can give checkmate in searchDepth moves
   */
-bool Chess::findCheckMate(Color colorOnMove, size_t searchDepth, bool addCheckMateMoves, size_t pruningSize) {
+SearchResult Chess::findCheckMate(Color colorOnMove, size_t searchDepth, bool addCheckMateMoves, size_t pruningSize,
+                                  bool verifyPruning) {
+    return findCheckMate(colorOnMove, searchDepth, addCheckMateMoves,
+                         PruningPolicy::symmetric(pruningSize, verifyPruning));
+}
+
+
+/**
+ * @brief Check if color can give checkmate in searchDepth moves, moves are pruned by pruning policy
+ * @param colorOnMove color of player on move
+ * @param searchDepth number of one color moves to check in minimax
+ * @param addCheckMateMoves if true, mating line will be added to checkMateList_
+ * @param pruningPolicy number of moves to consider for attacker and defender
+ * @return result of search, converts to true if colorOnMove can give checkmate in searchDepth moves
+ */
+SearchResult Chess::findCheckMate(Color colorOnMove, size_t searchDepth, bool addCheckMateMoves,
+                                  const PruningPolicy &pruningPolicy) {
+    TRACE_SCOPE("search");
+    AllocationScope allocationScope;
+    auto start = std::chrono::steady_clock::now();
+
     // setup and call minimax
-    setupMinimax(searchDepth, addCheckMateMoves, pruningSize);
-    int evaluation = minimax(colorOnMove, searchDepth_);
+    setupMinimax(searchDepth, addCheckMateMoves, pruningPolicy);
+    attackerColor_ = colorOnMove;
+
+    // cached result is exact, so it is returned for any pruning policy
+    std::uint64_t hash = solutionCache_ ? positionHash(colorOnMove) : 0;
+    std::optional<SearchResult> cached = solutionCache_ ? solutionCache_->find(hash, colorOnMove, searchDepth) :
+                                         std::nullopt;
+    if (cached) {
+        cached->cached = true;
+        bestStartingMove_ = cached->bestMove;
+        if (cached->checkMate && addCheckmateMoves_) {
+            checkMateList_.push_back(cached->principalVariation);
+        }
+        cached->time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (reporter_) {
+            reporter_->searchFinished(*cached);
+        }
+        return *cached;
+    }
+
+    if (reporter_) {
+        reporter_->searchStarted(pruningPolicy_);
+    }
+    int evaluation = pruningPolicy_.verify ? verifiedMinimax(colorOnMove) : minimax(colorOnMove, searchDepth_);
+
+    // interrupted search proves only checkmate given by finished root move, other values are just bounds
+    if (searchStatus_ != SearchStatus::COMPLETED && !isAttackerCheckMate(evaluation)) {
+        evaluation = 0;
+    }
 
     // deal results
-    if (evaluation == INT_MAX || evaluation == INT_MIN) {
-        dealCheckmateFound();
-        return true;
+    SearchResult result = createSearchResult(evaluation, searchDepth);
+    if (result.checkMate && tablebases_) {
+        completeMatingLine(result.principalVariation, colorOnMove);
+    }
+    if (result.checkMate && addCheckmateMoves_) {
+        checkMateList_.push_back(result.principalVariation);
+    }
+    if (solutionCache_ && isExactResult(result)) {
+        solutionCache_->store(hash, colorOnMove, searchDepth, result);
+    }
+    searchStats_.allocations = allocationScope.stats();
+    result.stats.allocations = searchStats_.allocations;
+    result.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (reporter_) {
+        reporter_->searchFinished(result);
+    }
+    return result;
+}
+
+
+/**
+ * @brief Create result of finished search
+ * @param evaluation value of best root move
+ * @param searchDepth number of one color moves searched
+ * @return result of search
+ */
+SearchResult Chess::createSearchResult(int evaluation, size_t searchDepth) const {
+    SearchResult result;
+    result.checkMate = isAttackerCheckMate(evaluation);
+    result.bestMove = bestStartingMove_;
+    result.score = evaluation;
+    result.stats = searchStats_;
+    result.status = searchStatus_;
+    result.depth = (searchStatus_ == SearchStatus::COMPLETED) ? searchDepth : 0;
+
+    // checkmate is given by attacker -> it is at odd ply
+    result.principalVariation = getPrincipalVariation();
+    result.mateDistance = result.checkMate ? (checkMatePly(evaluation) + 1) / 2 : 0;
+    return result;
+}
+
+
+/**
+ * @brief Check if result of last search is the same as result of full-width search, so it can be cached
+ * @param result result of last search
+ * @return true if result is exact
+ */
+bool Chess::isExactResult(const SearchResult &result) const {
+    if (result.status != SearchStatus::COMPLETED || lmrReduction_ != 0) {
+        return false;
+    }
+
+    // found checkmate is sound unless defender moves were pruned, but pruned attacker moves or reductions can hide
+    // a shorter one, so it is exact only if the last search cut off no attacker move
+    bool verified = !pruningPolicy_.prunes() || pruningPolicy_.verify;
+    if (result.checkMate) {
+        return !attackerPruned_ && (verified || !pruningPolicy_.prunesDefender());
+    }
+    return verified;
+}
+
+
+/**
+ * @brief Run minimax with pruningPolicy_ and make the result sound. Checkmate found with pruned defender moves is
+ * verified by re-search with all defender moves. If attacker moves were pruned and no checkmate or a checkmate in
+ * more than one move is found, policy is widened and search repeated, because pruned attacker moves could give a
+ * shorter one.
+ * @param colorOnMove color of player on move
+ * @return value of best move, same as full-width minimax
+ */
+int Chess::verifiedMinimax(Color colorOnMove) {
+    while (true) {
+        // narrow search -> both colors are pruned by policy
+        fullWidthDefender_ = false;
+        attackerPruned_ = false;
+        defenderPruned_ = false;
+        int evaluation = minimax(colorOnMove, searchDepth_);
+
+        // checkmate found with all defender moves is sound
+        bool sound = isAttackerCheckMate(evaluation) && !defenderPruned_;
+
+        // verify checkmate -> attacker needs only one good move, but every defender move has to be refuted
+        if (!sound && isAttackerCheckMate(evaluation) && searchStatus_ == SearchStatus::COMPLETED) {
+            fullWidthDefender_ = true;
+            attackerPruned_ = false;
+            evaluation = minimax(colorOnMove, searchDepth_);
+            fullWidthDefender_ = false;
+            sound = isAttackerCheckMate(evaluation);
+        }
+
+        // interrupted search keeps only sound checkmate, even if a shorter one might exist
+        if (searchStatus_ != SearchStatus::COMPLETED) {
+            return sound ? evaluation : 0;
+        }
+
+        // no attacker move was cut off -> pruned defender moves can only help attacker, so result is the same as
+        // full-width one, checkmate in one move cannot be shortened by pruned attacker moves
+        if (!attackerPruned_ || (sound && checkMatePly(evaluation) == 1)) {
+            return evaluation;
+        }
+        pruningPolicy_.widen();
     }
-    dealCheckmateNotFound(evaluation);
-    return false;
 }
 
 
@@ -282,10 +500,38 @@ bool Chess::findCheckMate(Color colorOnMove, size_t searchDepth, bool addCheckMa
  * @return value of best move
  */
 int Chess::minimax(Color colorOnMove, size_t searchDepth, int alpha, int beta) {
+    // scratch lists of the node and its subtree are freed at once when it returns
+    ArenaFrame frame(arena_);
+    ++searchStats_.nodes;
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), nodes, 1);
+    clearPrincipalVariation(minimaxMoves_.size());
+
+    // interrupted search -> value is ignored, callers only restore the board
+    if (searchInterrupted()) {
+        return 0;
+    }
     if (searchDepth == 0) {
         return deepEvaluation(colorOnMove);
     }
 
+    // mate distance pruning -> player on move is mated at this ply at worst and mates at the next ply at best
+    size_t ply = minimaxMoves_.size();
+    Color opponent = getOppositeColor(colorOnMove);
+    int worst = checkMateScore(colorOnMove, ply);
+    int best = checkMateScore(opponent, ply + 1);
+    alpha = std::max(alpha, std::min(worst, best));
+    beta = std::min(beta, std::max(worst, best));
+    if (alpha >= beta) {
+        return alpha;
+    }
+
+    // few pieces left -> endgame tables know the result, root is searched to get the best move
+    std::optional<int> tablebaseValue = (tablebases_ && !minimaxMoves_.empty()) ?
+                                        tablebaseEvaluation(colorOnMove, searchDepth) : std::nullopt;
+    if (tablebaseValue) {
+        return *tablebaseValue;
+    }
+
     // maximizing player
     if (colorOnMove == Color::WHITE) {
         return maximizer(searchDepth, alpha, beta);
@@ -296,6 +542,314 @@ int Chess::minimax(Color colorOnMove, size_t searchDepth, int alpha, int beta) {
 }
 
 
+/**
+ * @brief Look up current position in endgame tables
+ * @param colorOnMove color of player on move
+ * @return entry from view of colorOnMove, empty if there are more pieces or no table of the material
+ */
+std::optional<std::uint8_t> Chess::probeTablebases(Color colorOnMove) const {
+    TRACE_SCOPE("tablebaseProbe");
+    TablebasePosition position;
+    position.colorOnMove = colorOnMove;
+
+    // board is scanned only until the fifth piece is found
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            Piece piece = chessBoard_[x][y];
+            if (!piece.isEmpty() && !position.add(piece.getColor(), piece.getPieceType(), x * 8 + y)) {
+                return std::nullopt;
+            }
+        }
+    }
+    return tablebases_->probe(position);
+}
+
+
+/**
+ * @brief Evaluate position by endgame tables -> checkmate is exact if it fits to remaining depth, other positions
+ * are evaluated statically, because minimax cannot find checkmate there
+ * @param colorOnMove color of player on move
+ * @param searchDepth remaining search depth
+ * @return value of position, empty if position is not in tables
+ */
+std::optional<int> Chess::tablebaseEvaluation(Color colorOnMove, size_t searchDepth) {
+    std::optional<std::uint8_t> value = probeTablebases(colorOnMove);
+    if (!value) {
+        return std::nullopt;
+    }
+    ++searchStats_.tablebaseProbes;
+    if (*value == TABLEBASE_ILLEGAL) {
+        return std::nullopt;
+    }
+    ++searchStats_.tablebaseHits;
+
+    // minimax detects checkmate only with at least one move of depth left
+    if ((Tablebase::isWin(*value) || Tablebase::isLoss(*value)) && Tablebase::plies(*value) < searchDepth) {
+        Color matedColor = Tablebase::isWin(*value) ? getOppositeColor(colorOnMove) : colorOnMove;
+        return checkMateScore(matedColor, minimaxMoves_.size() + Tablebase::plies(*value));
+    }
+    return deepEvaluation(colorOnMove);
+}
+
+
+/**
+ * @brief Extend mating line which ends in tablebase position by optimal moves from tables until checkmate
+ * @param line mating line starting in current position
+ * @param colorOnMove color of player on move in current position
+ */
+void Chess::completeMatingLine(piece_moves &line, Color colorOnMove) {
+    std::vector<move_backup> backups;
+    for (const piece_move &move : line) {
+        backups.push_back(makeMove(move));
+        colorOnMove = getOppositeColor(colorOnMove);
+    }
+
+    // each move keeps the shortest checkmate -> distance of successor is one half-move shorter
+    std::optional<std::uint8_t> value = probeTablebases(colorOnMove);
+    while (value && (Tablebase::isWin(*value) || Tablebase::isLoss(*value)) && Tablebase::plies(*value) > 0) {
+        std::optional<std::uint8_t> successorValue;
+        for (const piece_move &move : getAllMoves(colorOnMove)) {
+            move_backup backup = makeMove(move);
+            successorValue = probeTablebases(getOppositeColor(colorOnMove));
+            if (successorValue && *successorValue != TABLEBASE_ILLEGAL &&
+                Tablebase::isWin(*successorValue) != Tablebase::isWin(*value) &&
+                Tablebase::plies(*successorValue) + 1 == Tablebase::plies(*value)) {
+                line.push_back(move);
+                backups.push_back(backup);
+                break;
+            }
+            undoMove(move, backup);
+            successorValue.reset();
+        }
+        value = successorValue;
+        colorOnMove = getOppositeColor(colorOnMove);
+    }
+
+    // take back the whole line
+    for (size_t i = line.size(); i-- > 0;) {
+        undoMove(line[i], backups[i]);
+    }
+}
+
+
+/**
+ * @brief Get Zobrist hash of position, positions with the same pieces and the same player on move have the same
+ * hash (there is no castling or en passant in the engine)
+ * @param colorOnMove color of player on move
+ * @return hash of position
+ */
+std::uint64_t Chess::positionHash(Color colorOnMove) const {
+    std::uint64_t hash = (colorOnMove == Color::BLACK) ? Zobrist::KEYS.blackToMove : 0;
+
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            Piece piece = chessBoard_[x][y];
+            hash ^= piece.isEmpty() ? 0 : Zobrist::pieceKey(piece.getColor(), piece.getPieceType(), x, y);
+        }
+    }
+    return hash;
+}
+
+
+/**
+ * @brief Find all attacker first moves which force checkmate in searchDepth moves and count all mating lines.
+ * Positions are memoized by hash and remaining depth, so transposed lines are solved once.
+ * @param colorOnMove color of attacker on move
+ * @param searchDepth number of attacker moves
+ * @param countLines if false, only mating first moves are found, which is faster
+ * @return mating first moves and number of mating lines
+ */
+MateSolutions Chess::findAllCheckMates(Color colorOnMove, size_t searchDepth, bool countLines) {
+    if (searchDepth == 0) {
+        throw InvalidSearchDepth();
+    }
+    setupMinimax(searchDepth, false, PruningPolicy());
+    attackerColor_ = colorOnMove;
+
+    MateSolutions solutions;
+    std::vector<mate_memo> memo(searchDepth + 1);
+    Color defender = (colorOnMove == Color::WHITE) ? Color::BLACK : Color::WHITE;
+
+    // root is not memoized -> lines are needed for each first move
+    for (const piece_move &move : getAllMoves(colorOnMove)) {
+        move_backup backup = makeMove(move);
+        size_t lines = countDefenderLines(defender, searchDepth, countLines, memo, solutions);
+        undoMove(move, backup);
+
+        if (searchStatus_ != SearchStatus::COMPLETED) {
+            break;
+        }
+        else if (lines > 0) {
+            solutions.firstMoves.push_back(move);
+            if (countLines) {
+                solutions.lineCounts.push_back(lines);
+            }
+            solutions.lineCount = countLines ? saturatingAdd(solutions.lineCount, lines) : 0;
+        }
+    }
+    solutions.status = searchStatus_;
+    return solutions;
+}
+
+
+/**
+ * @brief Count leaf nodes of legal move tree, moves are generated by getAllMoves and done by makeMove, counts of
+ * subtrees are reused from perft table if it is set
+ * @param colorOnMove color of player on move
+ * @param depth number of half-moves
+ * @return number of positions reached after depth half-moves
+ */
+size_t Chess::perft(Color colorOnMove, size_t depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    // transposed subtree was already counted, the last half-move is cheaper to count than to hash
+    bool hashed = perftTable_ && depth > 1;
+    std::uint64_t hash = hashed ? positionHash(colorOnMove) : 0;
+    std::optional<size_t> stored = hashed ? perftTable_->find(hash, depth) : std::nullopt;
+    if (stored) {
+        return *stored;
+    }
+
+    // generated moves are legal -> last half-move needs no make and undo
+    ArenaFrame frame(arena_);
+    move_list moves = getAllMoves(colorOnMove);
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    size_t nodes = 0;
+    for (const piece_move &move : moves) {
+        move_backup backup = makeMove(move);
+        nodes += perft(getOppositeColor(colorOnMove), depth - 1);
+        undoMove(move, backup);
+    }
+    if (hashed) {
+        perftTable_->store(hash, depth, nodes);
+    }
+    return nodes;
+}
+
+
+/**
+ * @brief Count leaf nodes of legal move tree separately for each root move
+ * @param colorOnMove color of player on move
+ * @param depth number of half-moves including root move, at least 1
+ * @return root moves in generation order with number of positions reached after each of them
+ */
+std::vector<std::pair<piece_move, size_t>> Chess::divide(Color colorOnMove, size_t depth) {
+    std::vector<std::pair<piece_move, size_t>> counts;
+    for (const piece_move &move : getAllMoves(colorOnMove)) {
+        move_backup backup = makeMove(move);
+        counts.emplace_back(move, perft(getOppositeColor(colorOnMove), depth - 1));
+        undoMove(move, backup);
+    }
+    return counts;
+}
+
+
+/**
+ * @brief Count mating lines with attacker on move
+ * @param attacker color of attacker
+ * @param searchDepth number of attacker moves left
+ * @param countLines if false, 1 is returned for any number of lines
+ * @param memo solved positions for each number of moves left
+ * @param solutions statistics to update
+ * @return number of mating lines, 0 if attacker cannot force checkmate
+ */
+size_t Chess::countAttackerLines(Color attacker, size_t searchDepth, bool countLines, std::vector<mate_memo> &memo,
+                                 MateSolutions &solutions) {
+    std::uint64_t hash = positionHash(attacker);
+    auto solved = memo[searchDepth].find(hash);
+    if (solved != memo[searchDepth].end()) {
+        ++solutions.transpositions;
+        return solved->second;
+    }
+
+    ++searchStats_.nodes;
+    if (searchInterrupted()) {
+        return 0;
+    }
+
+    size_t lines = 0;
+    Color defender = (attacker == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    ArenaFrame frame(arena_);
+    for (const piece_move &move : getAllMoves(attacker)) {
+        move_backup backup = makeMove(move);
+        lines = saturatingAdd(lines, countDefenderLines(defender, searchDepth, countLines, memo, solutions));
+        undoMove(move, backup);
+
+        if (lines > 0 && !countLines) {
+            break;
+        }
+    }
+
+    // result of interrupted search is not exact -> it is not stored
+    if (searchStatus_ == SearchStatus::COMPLETED) {
+        memo[searchDepth].emplace(hash, lines);
+        ++solutions.positions;
+    }
+    return lines;
+}
+
+
+/**
+ * @brief Count mating lines with defender on move, each defender move has to lose
+ * @param defender color of defender
+ * @param searchDepth number of attacker moves left, including the move which was just played
+ * @param countLines if false, 1 is returned for any number of lines
+ * @param memo solved positions for each number of moves left
+ * @param solutions statistics to update
+ * @return number of mating lines, 0 if some defender move avoids checkmate
+ */
+size_t Chess::countDefenderLines(Color defender, size_t searchDepth, bool countLines, std::vector<mate_memo> &memo,
+                                 MateSolutions &solutions) {
+    ArenaFrame frame(arena_);
+    move_list moves = getAllMoves(defender);
+
+    // checkmate ends the line, stalemate or no attacker moves left is not checkmate
+    if (moves.empty()) {
+        return kingHasCheck(defender) ? 1 : 0;
+    }
+    else if (searchDepth == 1) {
+        return 0;
+    }
+
+    size_t lines = 0;
+    Color attacker = (defender == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    for (const piece_move &move : moves) {
+        move_backup backup = makeMove(move);
+        size_t moveLines = countAttackerLines(attacker, searchDepth - 1, countLines, memo, solutions);
+        undoMove(move, backup);
+
+        if (moveLines == 0) {
+            return 0;
+        }
+        lines = countLines ? saturatingAdd(lines, moveLines) : 1;
+    }
+    return lines;
+}
+
+
+/**
+ * @brief Check if running search should be interrupted, deadline and stop flag are polled every pollInterval nodes
+ * @return true if search has to be interrupted
+ */
+bool Chess::searchInterrupted() {
+    if (searchStatus_ != SearchStatus::COMPLETED) {
+        return true;
+    }
+    else if (searchLimits_.maxNodes != 0 && searchStats_.nodes > searchLimits_.maxNodes) {
+        searchStatus_ = SearchStatus::NODE_LIMIT;
+    }
+    else if (searchStats_.nodes % std::max<size_t>(searchLimits_.pollInterval, 1) == 0) {
+        searchStatus_ = searchLimits_.poll();
+    }
+    return searchStatus_ != SearchStatus::COMPLETED;
+}
+
+
 /**
  * @brief Find best move for maximizing player == white
  * @param searchDepth search depth
@@ -304,51 +858,65 @@ int Chess::minimax(Color colorOnMove, size_t searchDepth, int alpha, int beta) {
  * @return value of best move
  */
 int Chess::maximizer(size_t searchDepth, int alpha, int beta) {
-    std::vector<piece_move> moves = getBestMoves(Color::WHITE);
-    int maxEval = INT_MIN;
-
-    for (const piece_move &move : moves) {
+    move_list moves = getBestMoves(Color::WHITE, minimaxMoves_.size());
+    int maxEval = checkMateScore(Color::WHITE, minimaxMoves_.size());
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), expanded, 1);
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), generatedMoves, moves.size());
+
+    for (size_t moveNumber = 0; moveNumber < moves.size(); ++moveNumber) {
+        const piece_move &move = moves[moveNumber];
+        size_t reduction = lateMoveReduction(Color::WHITE, searchDepth, moveNumber, move);
         Position positionFrom = move.first;
         Position positionTo = move.second;
 
         // create piece backups -> at positionFrom might be pawn which will be promoted to queen, rook, etc.
-        piece_ptr pieceBackupFrom = chessBoard_[positionFrom.x_][positionFrom.y_];
-        piece_ptr pieceBackupTo = chessBoard_[positionTo.x_][positionTo.y_];
+        Piece pieceBackupFrom = chessBoard_[positionFrom.x_][positionFrom.y_];
+        Piece pieceBackupTo = chessBoard_[positionTo.x_][positionTo.y_];
 
         // update state
         movePiece(move);
 
         // evaluate position
         minimaxMoves_.push_back(move);
-        int eval = minimax(Color::BLACK, searchDepth - 1, alpha, beta);
+        int eval = minimax(Color::BLACK, searchDepth - 1 - reduction, alpha, beta);
+
+        // reduced move failed high -> search it again with full depth, checkmate in less moves is still checkmate
+        if (reduction > 0 && eval > alpha && !isCheckMateEvaluation(eval)) {
+            ++searchStats_.reSearches;
+            eval = minimax(Color::BLACK, searchDepth - 1, alpha, beta);
+        }
         minimaxMoves_.pop_back();
 
         // restore state -> make reverse updatePosition and restore piece at positionTo
         chessBoard_[positionTo.x_][positionTo.y_] = pieceBackupFrom;
         movePiece({positionTo, positionFrom});
         chessBoard_[positionTo.x_][positionTo.y_] = pieceBackupTo;
+        if (searchStatus_ != SearchStatus::COMPLETED) {
+            break;
+        }
 
-        // reset checkmate moves if it is not checkmate + save starting updatePosition if better than previous
-        if (searchDepth == searchDepth_) {
-            (eval != INT_MAX) ? resetCheckMateMove() : void(0);
-            bestStartingMove_ = (eval > maxEval) ? move : bestStartingMove_;
+        // first or better move -> extend its line, save starting move at root
+        if (moveNumber == 0 || eval > maxEval) {
+            updatePrincipalVariation(minimaxMoves_.size(), move);
+            bestStartingMove_ = (searchDepth == searchDepth_) ? move : bestStartingMove_;
         }
 
         // apply alpha-beta pruning
         maxEval = std::max(maxEval, eval);
         alpha = std::max(alpha, eval);
         if (beta <= alpha) {
+            storeRefutation(Color::WHITE, minimaxMoves_.size(), move);
+            COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), cutoffs, 1);
+            COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), firstMoveCutoffs, moveNumber == 0 ? 1 : 0);
             break;
         }
     }
 
-    // if it is draw or checkmate
+    // if it is draw
     if (moves.empty() && !kingHasCheck(Color::WHITE)) {
         return 0;
     }
-    else if (moves.empty() && addCheckmateMoves_) {
-        addCheckMateMove();
-    }
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), mates, moves.empty() ? 1 : 0);
     return maxEval;
 }
 
@@ -361,55 +929,103 @@ int Chess::maximizer(size_t searchDepth, int alpha, int beta) {
  * @return
  */
 int Chess::minimizer(size_t searchDepth, int alpha, int beta) {
-    std::vector<piece_move> moves = getBestMoves(Color::BLACK);
-    int minEval = INT_MAX;
-
-    for (const piece_move &move : moves) {
+    move_list moves = getBestMoves(Color::BLACK, minimaxMoves_.size());
+    int minEval = checkMateScore(Color::BLACK, minimaxMoves_.size());
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), expanded, 1);
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), generatedMoves, moves.size());
+
+    for (size_t moveNumber = 0; moveNumber < moves.size(); ++moveNumber) {
+        const piece_move &move = moves[moveNumber];
+        size_t reduction = lateMoveReduction(Color::BLACK, searchDepth, moveNumber, move);
         Position positionFrom = move.first;
         Position positionTo = move.second;
 
         // create piece backups -> at positionFrom might be pawn which will be promoted to queen, rook, etc.
-        piece_ptr pieceBackupFrom = chessBoard_[positionFrom.x_][positionFrom.y_];
-        piece_ptr pieceBackupTo = chessBoard_[positionTo.x_][positionTo.y_];
+        Piece pieceBackupFrom = chessBoard_[positionFrom.x_][positionFrom.y_];
+        Piece pieceBackupTo = chessBoard_[positionTo.x_][positionTo.y_];
 
         // update state
         movePiece(move);
 
         // evaluate position
         minimaxMoves_.push_back(move);
-        int eval = minimax(Color::WHITE, searchDepth - 1, alpha, beta);
+        int eval = minimax(Color::WHITE, searchDepth - 1 - reduction, alpha, beta);
+
+        // reduced move failed high -> search it again with full depth, checkmate in less moves is still checkmate
+        if (reduction > 0 && eval < beta && !isCheckMateEvaluation(eval)) {
+            ++searchStats_.reSearches;
+            eval = minimax(Color::WHITE, searchDepth - 1, alpha, beta);
+        }
         minimaxMoves_.pop_back();
 
         // restore state -> make reverse updatePosition and restore piece at positionTo
         chessBoard_[positionTo.x_][positionTo.y_] = pieceBackupFrom;
         movePiece({positionTo, positionFrom});
         chessBoard_[positionTo.x_][positionTo.y_] = pieceBackupTo;
+        if (searchStatus_ != SearchStatus::COMPLETED) {
+            break;
+        }
 
-        // reset checkmate moves if it is not checkmate + save starting updatePosition if better than previous
-        if (searchDepth == searchDepth_) {
-            (eval != INT_MIN) ? resetCheckMateMove() : void(0);
-            bestStartingMove_ = (eval < minEval) ? move : bestStartingMove_;
+        // first or better move -> extend its line, save starting move at root
+        if (moveNumber == 0 || eval < minEval) {
+            updatePrincipalVariation(minimaxMoves_.size(), move);
+            bestStartingMove_ = (searchDepth == searchDepth_) ? move : bestStartingMove_;
         }
 
         // evaluate returned value
         minEval = std::min(minEval, eval);
         beta = std::min(beta, eval);
         if (beta <= alpha) {
+            storeRefutation(Color::BLACK, minimaxMoves_.size(), move);
+            COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), cutoffs, 1);
+            COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), firstMoveCutoffs, moveNumber == 0 ? 1 : 0);
             break;
         }
     }
 
-    // if it is draw or checkmate
+    // if it is draw
     if (moves.empty() && !kingHasCheck(Color::BLACK)) {
         return 0;
     }
-    else if (moves.empty() && addCheckmateMoves_) {
-        addCheckMateMove();
-    }
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), mates, moves.empty() ? 1 : 0);
     return minEval;
 }
 
 
+/**
+ * @brief Get depth reduction for late quiet attacker move, reduction is in whole moves so the same color is on move
+ * at the end of search
+ * @param colorOnMove color of player on move
+ * @param searchDepth search depth
+ * @param moveNumber index of move in ordered moves
+ * @param move move to reduce
+ * @return number of half-moves to reduce, 0 if move is searched with full depth
+ */
+size_t Chess::lateMoveReduction(Color colorOnMove, size_t searchDepth, size_t moveNumber, const piece_move &move) {
+    size_t reduction = 2 * lmrReduction_;
+
+    if (reduction == 0 || colorOnMove != attackerColor_ || moveNumber < lmrFullDepthMoves_ ||
+        searchDepth <= reduction + 1 || !isQuietMove(move)) {
+        return 0;
+    }
+    ++searchStats_.reductions;
+    return reduction;
+}
+
+
+/**
+ * @brief Check if move is quiet -> it does not capture (losing captures are quiet), give check or promote pawn
+ * @param move move to check
+ * @return true if move is quiet
+ */
+bool Chess::isQuietMove(const piece_move &move) {
+    Piece piece = chessBoard_[move.first.x_][move.first.y_];
+    bool promotion = piece.getPieceType() == PieceType::PAWN && (move.second.x_ == 0 || move.second.x_ == 7);
+
+    return !promotion && captureExchangeBonus(move) <= 0 && willBeCheckBonus(move) == 0;
+}
+
+
 /**
  * @brief Move piece on chessboard
  * @param move move to do
@@ -425,32 +1041,32 @@ void Chess::movePiece(const piece_move &move) {
     size_t toY = toPosition.y_;
 
     // updatePosition piece
-    chessBoard_[fromX][fromY]->updatePosition(toPosition);
-    chessBoard_[toX][toY] = chessBoard_[fromX][fromY];
-    chessBoard_[fromX][fromY] = nullptr;
+    Piece piece = chessBoard_[fromX][fromY];
+    chessBoard_[toX][toY] = piece;
+    chessBoard_[fromX][fromY] = Piece();
 
     // update king position
-    if (chessBoard_[toX][toY]->getPieceType() == PieceType::KING) {
-        (chessBoard_[toX][toY]->getColor() == Color::WHITE) ? whiteKing_ = chessBoard_[toX][toY] : blackKing_ = chessBoard_[toX][toY];
+    if (piece.getPieceType() == PieceType::KING) {
+        (piece.getColor() == Color::WHITE) ? whiteKingPosition_ = toPosition : blackKingPosition_ = toPosition;
     }
     // check if pawn should be transformed
-    else if (chessBoard_[toX][toY]->getPieceType() == PieceType::PAWN && (toX == 0 || toX == 7)) {
+    else if (piece.getPieceType() == PieceType::PAWN && (toX == 0 || toX == 7)) {
         transformPawn(toPosition);
     }
 }
 
 
 /**
- * @brief Get all pieces of color
+ * @brief Get positions of all pieces of color in board order
  * @param color color if pieces to get
- * @return vector of pieces
- */
-std::vector<piece_ptr> Chess::getPieces(Color color) const {
-    std::vector<piece_ptr> pieces;
-    for (const auto & row : chessBoard_) {
-        for (const auto & piece : row) {
-            if (piece != nullptr && piece->getColor() == color) {
-                pieces.push_back(piece);
+ * @return vector of piece positions
+ */
+position_list Chess::getPieces(Color color) const {
+    position_list pieces(scratch());
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            if (!chessBoard_[x][y].isEmpty() && chessBoard_[x][y].getColor() == color) {
+                pieces.emplace_back(x, y);
             }
         }
     }
@@ -461,41 +1077,112 @@ std::vector<piece_ptr> Chess::getPieces(Color color) const {
 /**
  * @brief Get best moves for color -> they are chosen using quickEvaluation
  * @param color color of player on move
+ * @param ply number of half-moves from the root of minimax
  * @return vector of best moves
  */
-std::vector<piece_move> Chess::getBestMoves(Color myColor) {
-    std::vector<piece_move> moves = getAllMoves(myColor);
+move_list Chess::getBestMoves(Color myColor, size_t ply) {
+    move_list moves = getAllMoves(myColor);
+    TRACE_SCOPE("ordering");
 
-    // sort moves by quick evaluation -> we want to check first moves which are more likely to be good
-    std::sort(moves.begin(), moves.end(), [this](const piece_move &move1, const piece_move &move2) {
-        return quickEvaluation(move1) > quickEvaluation(move2);
-    });
+    // evaluate each move only once, sorting calls comparator many times
+    std::pmr::vector<std::pair<int, piece_move>> scoredMoves(scratch());
+    scoredMoves.reserve(moves.size());
+    for (const piece_move &move : moves) {
+        scoredMoves.emplace_back(quickEvaluation(move), move);
+    }
+
+    // defender tries first moves which refuted attacker before
+    bool attacker = myColor == attackerColor_;
+    if (!attacker) {
+        orderRefutations(scoredMoves, ply);
+    }
+
+    // sort moves by quick evaluation -> we want to check first moves which are more likely to be good, insertion
+    // keeps order of equal moves like stable_sort, but without its temporary buffer
+    auto better = [](const auto &move1, const auto &move2) {
+        return move1.first > move2.first;
+    };
+    for (auto it = scoredMoves.begin(); it != scoredMoves.end(); ++it) {
+        std::rotate(std::upper_bound(scoredMoves.begin(), it, *it, better), it, it + 1);
+    }
+
+    // defender moves are not pruned while verifying checkmate
+    size_t pruningSize = (fullWidthDefender_ && !attacker) ? PRUNING_SIZE : pruningPolicy_.width(attacker, ply);
+    if (scoredMoves.size() > pruningSize) {
+        if (attacker) {
+            attackerPruned_ = true;
+        }
+        else {
+            defenderPruned_ = true;
+        }
+        scoredMoves.resize(pruningSize);
+    }
 
-    if (moves.size() > pruningSize_) {
-        return {moves.begin(), moves.begin() + pruningSize_};
+    moves.clear();
+    for (const auto &scoredMove : scoredMoves) {
+        moves.push_back(scoredMove.second);
     }
     return moves;
 }
 
 
+/**
+ * @brief Move counter move of previous attacker move to the first place and refutation at ply to the second place
+ * @param scoredMoves defender moves with their quick evaluation
+ * @param ply number of half-moves from the root of minimax
+ */
+void Chess::orderRefutations(std::pmr::vector<std::pair<int, piece_move>> &scoredMoves, size_t ply) const {
+    const piece_move &counterMove = minimaxMoves_.empty() ? piece_move() : getCounterMove(minimaxMoves_.back());
+    const piece_move &refutation = (ply < refutations_.size()) ? refutations_[ply] : piece_move();
+
+    for (auto &scoredMove : scoredMoves) {
+        if (scoredMove.second == counterMove) {
+            scoredMove.first = INT_MAX;
+        }
+        else if (scoredMove.second == refutation) {
+            scoredMove.first = INT_MAX - 1;
+        }
+    }
+}
+
+
+/**
+ * @brief Save defender move which caused cutoff -> attacker move before it was refuted
+ * @param colorOnMove color of player who made the move
+ * @param ply number of half-moves from the root of minimax
+ * @param move move which caused cutoff
+ */
+void Chess::storeRefutation(Color colorOnMove, size_t ply, const piece_move &move) {
+    if (colorOnMove == attackerColor_ || minimaxMoves_.empty()) {
+        return;
+    }
+    const piece_move &attackerMove = minimaxMoves_.back();
+    counterMoves_[squareIndex(attackerMove.first)][squareIndex(attackerMove.second)] = move;
+
+    if (ply < refutations_.size()) {
+        refutations_[ply] = move;
+    }
+}
+
+
 /**
  * @brief Get all moves for color
  * @param color color of player on move
  * @return vector of all moves
  */
-std::vector<piece_move> Chess::getAllMoves(Color color) {
-    std::vector<piece_move> allMoves;
-    Position originalPosition;
+move_list Chess::getAllMoves(Color color) {
+    TRACE_SCOPE("moveGeneration");
+    move_list allMoves(scratch());
 
     // if king is in check -> we can updatePosition only king or block check, these moves are returned
     if (needsToBlockCheck(color, allMoves)) {
         return allMoves;
     }
-    for (const piece_ptr &piece: getPieces(color)) {
-        originalPosition = piece->getPosition();
+    for (const Position &originalPosition : getPieces(color)) {
+        Piece piece = chessBoard_[originalPosition.x_][originalPosition.y_];
 
         // get all possible moves for piece
-        for (Position position: piece->getPossibleMoves(*this)) {
+        for (Position position: piece.getPossibleMoves(*this, originalPosition)) {
             allMoves.emplace_back(originalPosition, position);
         }
     }
@@ -504,19 +1191,115 @@ std::vector<piece_move> Chess::getAllMoves(Color color) {
 
 
 /**
- * @brief quick evaluation of move, capturing moves or moves giving checkmate are preferred
+ * @brief quick evaluation of move, capturing moves or moves giving checkmate are preferred, losing captures are
+ * tried last
  * @param move move to evaluate
  * @return value of move
  */
 int Chess::quickEvaluation(const piece_move &move) {
     int evaluation = 0;
-    evaluation += captureEnemyBonus(move.second);
+    int checkBonus = willBeCheckBonus(move);
+
+    // sacrifice giving check often starts checkmate -> only captures without check are judged by exchange
+    evaluation += (checkBonus > 0) ? captureEnemyBonus(move.second) : captureExchangeBonus(move);
     evaluation += betterPositionBonus(move);
-    evaluation += willBeCheckBonus(move);
+    evaluation += checkBonus;
     return evaluation;
 }
 
 
+/**
+ * @brief static exchange evaluation -> material balance after all captures on target square of move, each
+ * player captures with the least valuable piece and can stop capturing when it is not profitable
+ * @param move capturing move to evaluate
+ * @return material won (positive) or lost (negative) by player making the move
+ */
+int Chess::staticExchangeEvaluation(const piece_move &move) const {
+    const Position &target = move.second;
+    Piece piece = chessBoard_[move.first.x_][move.first.y_];
+    bool removed[8][8] = {};
+    int gain[SEE_MAX_EXCHANGES];
+    size_t depth = 0;
+
+    // first capture is given by move
+    gain[0] = isFree(target) ? 0 : exchangeValue(chessBoard_[target.x_][target.y_]);
+    int attackerValue = exchangeValue(piece);
+    removed[move.first.x_][move.first.y_] = true;
+    Color color = getOppositeColor(piece.getColor());
+
+    // players capture on target with the least valuable piece until there is no attacker
+    while (depth + 1 < SEE_MAX_EXCHANGES) {
+        Position attacker = leastValuableAttacker(target, color, removed);
+        if (!onChessboard(attacker)) {
+            break;
+        }
+        ++depth;
+        gain[depth] = attackerValue - gain[depth - 1];
+        attackerValue = exchangeValue(chessBoard_[attacker.x_][attacker.y_]);
+        removed[attacker.x_][attacker.y_] = true;
+        color = getOppositeColor(color);
+    }
+
+    // go back through the swap list -> player can always stop capturing
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
+    }
+    return gain[0];
+}
+
+
+/**
+ * @brief find the least valuable piece of color attacking target, pieces hidden behind removed pieces (x-rays)
+ * are also found
+ * @param target attacked position
+ * @param color color of attacking pieces
+ * @param removed positions of pieces which already captured on target
+ * @return position of the least valuable attacker, invalid position if there is no attacker
+ */
+Position Chess::leastValuableAttacker(const Position &target, Color color, const bool removed[8][8]) const {
+    Position bestAttacker;
+    int bestValue = INT_MAX;
+
+    // check if there is attacking piece on position, pieceTypes are pieces which can attack from there
+    auto inspect = [&](const Position &position, std::initializer_list<PieceType> pieceTypes) {
+        if (!onChessboard(position) || isFree(position) || removed[position.x_][position.y_]) {
+            return;
+        }
+        Piece piece = chessBoard_[position.x_][position.y_];
+        if (piece.getColor() == color && exchangeValue(piece) < bestValue &&
+            std::find(pieceTypes.begin(), pieceTypes.end(), piece.getPieceType()) != pieceTypes.end()) {
+            bestAttacker = position;
+            bestValue = exchangeValue(piece);
+        }
+    };
+
+    // pawns attack target from the opposite direction of their capture moves
+    for (const Vector2D &captureMove : Pawn::getCaptureMoves(color)) {
+        inspect(target + captureMove * -1, {PieceType::PAWN});
+    }
+    for (const Vector2D &knightMove : Knight::getVectorMoves()) {
+        inspect(target + knightMove, {PieceType::KNIGHT});
+    }
+    for (const Vector2D &kingMove : King::getVectorMoves()) {
+        inspect(target + kingMove, {PieceType::KING});
+    }
+
+    // sliding pieces -> skip free squares and pieces which already captured
+    for (const Vector2D &direction : Queen::getVectorMoves()) {
+        Position position = target + direction;
+        while (onChessboard(position) && (isFree(position) || removed[position.x_][position.y_])) {
+            position += direction;
+        }
+        if (onChessboard(position) && chessBoard_[position.x_][position.y_].isCheckBlockAble() &&
+            chessBoard_[position.x_][position.y_].canMoveDirection(direction)) {
+            inspect(position, {PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN});
+        }
+    }
+    return bestAttacker;
+}
+
+
 /**
  * @brief bonus for moving piece to better position, we prefer positions closer to enemy king
  * @param move move to evaluate
@@ -525,10 +1308,10 @@ int Chess::quickEvaluation(const piece_move &move) {
 int Chess::betterPositionBonus(const piece_move &move) {
     Position positionFrom = move.first;
     Position positionTo = move.second;
-    piece_ptr piece = chessBoard_[positionFrom.x_][positionFrom.y_];
+    Piece piece = chessBoard_[positionFrom.x_][positionFrom.y_];
 
-    Color myColor = piece->getColor();
-    PieceType pieceType = piece->getPieceType();
+    Color myColor = piece.getColor();
+    PieceType pieceType = piece.getPieceType();
     Position enemyKingPosition = this->enemyKingPosition(myColor);
 
     if (pieceType == PieceType::KING) {
@@ -549,12 +1332,14 @@ int Chess::betterPositionBonus(const piece_move &move) {
  * @return
  */
 int Chess::deepEvaluation(Color colorOnMove) {
+    TRACE_SCOPE("leafEvaluation");
+    COUNT_PLY_STAT(searchStats_, minimaxMoves_.size(), leaves, 1);
     int evaluation = 0;
 
-    for (const auto & row : chessBoard_) {
-        for (const auto & piece : row) {
-            if (piece != nullptr) {
-                evaluation += evaluatePiece(piece);
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            if (!chessBoard_[x][y].isEmpty()) {
+                evaluation += evaluatePiece(chessBoard_[x][y], Position(x, y));
             }
         }
     }
@@ -576,41 +1361,137 @@ std::ostream& operator<<(std::ostream& os, const piece_move & move) {
 
 
 /**
- * @brief deal situation when checkmate was found
+ * @brief Play move given in coordinate notation (e.g. e2e4, e7e8q), move has to be legal
+ * @param notation move in coordinate notation
+ * @param colorOnMove color of player on move
  */
-void Chess::dealCheckmateFound() const {
-    std::cout << "Checkmate founded!" << std::endl;
-    std::cout << "Start: " << bestStartingMove_ << std::endl;
-    std::cout << std::endl;
+void Chess::playMove(const std::string &notation, Color colorOnMove) {
+    // promotion without piece letter is promotion to queen
+    std::string promotion = notation.size() == 5 ? notation.substr(4) : "q";
+    if (notation.size() != 4 && notation.size() != 5) {
+        throw InvalidMove(notation);
+    }
+
+    for (const piece_move &move : getAllMoves(colorOnMove)) {
+        std::string moveText = moveNotation(move);
+        if (moveText == notation || (moveText.size() == 5 && moveText == notation.substr(0, 4) + promotion)) {
+            movePiece(move);
+            return;
+        }
+    }
+    playSpecialMove(notation, colorOnMove);
 }
 
 
 /**
- * @brief deal situation when checkmate was not found
- * @param evaluation evaluation of game position
+ * @brief Play castling or en passant, minimax does not generate these moves but they can appear in played games
+ * @param notation move in coordinate notation
+ * @param colorOnMove color of player on move
  */
-void Chess::dealCheckmateNotFound(int evaluation) const {
-    std::cout << "No checkmate founded, ";
-    printGameAnalysis(evaluation);
-    std::cout << "Good updatePosition could be: " << bestStartingMove_;
-    std::cout << std::endl;
+void Chess::playSpecialMove(const std::string &notation, Color colorOnMove) {
+    Position from('8' - notation[1], notation[0] - 'a');
+    Position to('8' - notation[3], notation[2] - 'a');
+    if (!onChessboard(from) || !onChessboard(to) || isFree(from) ||
+        chessBoard_[from.x_][from.y_].getColor() != colorOnMove) {
+        throw InvalidMove(notation);
+    }
+    PieceType pieceType = chessBoard_[from.x_][from.y_].getPieceType();
+
+    // castling -> king moves two columns, rook jumps over it
+    if (pieceType == PieceType::KING && from.x_ == to.x_ && std::abs(from.y_ - to.y_) == 2 && isFree(to)) {
+        Position rookFrom(from.x_, to.y_ > from.y_ ? 7 : 0);
+        Position rookTo(from.x_, (from.y_ + to.y_) / 2);
+        if (isFree(rookFrom) || chessBoard_[rookFrom.x_][rookFrom.y_].getPieceType() != PieceType::ROOK ||
+            !isFree(rookTo)) {
+            throw InvalidMove(notation);
+        }
+        movePiece({from, to});
+        movePiece({rookFrom, rookTo});
+    }
+    // en passant -> pawn moves diagonally to free square, captured pawn is next to it
+    else if (pieceType == PieceType::PAWN && std::abs(from.y_ - to.y_) == 1 && isFree(to)) {
+        Position captured(from.x_, to.y_);
+        if (isFree(captured) || chessBoard_[captured.x_][captured.y_].getPieceType() != PieceType::PAWN) {
+            throw InvalidMove(notation);
+        }
+        chessBoard_[captured.x_][captured.y_] = Piece();
+        movePiece({from, to});
+    }
+    else {
+        throw InvalidMove(notation);
+    }
 }
 
 
 /**
- * @brief print game analysis
- * @param evaluation evaluation of game position
+ * @brief Get move in coordinate notation (e.g. e2e4, e7e8q), move has to be legal in current position
+ * @param move move to convert
+ * @return move in coordinate notation, empty string if move is not on chessboard
  */
-void Chess::printGameAnalysis(int evaluation) {
-    if (evaluation > 0) {
-        std::cout << "WHITE has material advantage." << std::endl;
+std::string Chess::moveNotation(const piece_move &move) const {
+    if (!onChessboard(move.first) || !onChessboard(move.second) || isFree(move.first)) {
+        return "";
     }
-    else if (evaluation < 0) {
-        std::cout << "BLACK has material advantage." << std::endl;
+    std::string notation = positionNotation(move.first) + positionNotation(move.second);
+
+    // pawn reaching last row is promoted to piece given by transformTo_
+    Piece piece = chessBoard_[move.first.x_][move.first.y_];
+    if (piece.getPieceType() == PieceType::PAWN && (move.second.x_ == 0 || move.second.x_ == 7)) {
+        switch (move.second.transformTo_) {
+            case PieceType::ROOK:
+                notation += 'r';
+                break;
+            case PieceType::BISHOP:
+                notation += 'b';
+                break;
+            case PieceType::KNIGHT:
+                notation += 'n';
+                break;
+            default:
+                notation += 'q';
+        }
     }
-    else {
-        std::cout << "NO player has material advantage" << std::endl;
+    return notation;
+}
+
+
+/**
+ * @brief Get line of moves in coordinate notation, moves are played on the board and then taken back
+ * @param line moves of both players starting in current position
+ * @return moves in coordinate notation
+ */
+std::vector<std::string> Chess::lineNotation(const piece_moves &line) {
+    std::vector<std::string> notation;
+    std::vector<move_backup> backups;
+
+    // notation of promotion depends on piece on the board -> moves have to be played
+    for (const piece_move &move : line) {
+        notation.push_back(moveNotation(move));
+        backups.push_back(makeMove(move));
+    }
+
+    // restore state in reverse order
+    for (size_t i = line.size(); i-- > 0;) {
+        undoMove(line[i], backups[i]);
     }
+    return notation;
+}
+
+
+/**
+ * @brief Set best line of node at ply to move followed by best line of its child
+ * @param ply number of half-moves from the root of minimax
+ * @param move new best move of node
+ */
+void Chess::updatePrincipalVariation(size_t ply, const piece_move &move) {
+    size_t rowSize = searchDepth_ + 1;
+    piece_move *row = &pvTable_[ply * rowSize];
+    const piece_move *childRow = &pvTable_[(ply + 1) * rowSize];
+
+    // rows are indexed by ply, so the line of child starts at column ply + 1 in both rows
+    row[ply] = move;
+    std::copy(childRow + ply + 1, childRow + pvLength_[ply + 1], row + ply + 1);
+    pvLength_[ply] = pvLength_[ply + 1];
 }
 
 
@@ -640,16 +1521,12 @@ void Chess::transformPawn(const Position &position) {
 
     switch (pieceType) {
         case PieceType::QUEEN:
-            chessBoard_[x][y] = std::make_shared<Queen>(chessBoard_[x][y]->getColor(), position);
-            break;
         case PieceType::ROOK:
-            chessBoard_[x][y] = std::make_shared<Rook>(chessBoard_[x][y]->getColor(), position);
-            break;
         case PieceType::BISHOP:
-            chessBoard_[x][y] = std::make_shared<Bishop>(chessBoard_[x][y]->getColor(), position);
-            break;
         case PieceType::KNIGHT:
-            chessBoard_[x][y] = std::make_shared<Knight>(chessBoard_[x][y]->getColor(), position);
+            chessBoard_[x][y] = Piece(chessBoard_[x][y].getColor(), pieceType);
+            break;
+        default:
             break;
     }
 }
@@ -676,7 +1553,7 @@ void Chess::validatePosition(const Position &position) const {
  * @return true if king is checked by enemy knight
  */
 bool Chess::isCheckedByKnight(Color kingColor, Position &checkingPiece) {
-    std::vector<Vector2D> knightMoves = Knight::getVectorMoves();
+    std::span<const Vector2D> knightMoves = Knight::getVectorMoves();
     Position myKingPosition = this->myKingPosition(kingColor);
 
     for (const auto &move : knightMoves) {
@@ -684,8 +1561,8 @@ bool Chess::isCheckedByKnight(Color kingColor, Position &checkingPiece) {
         if (onChessboard(newPosition) && !isFree(newPosition)) {
 
             // if there is a knight of the opposite color
-            piece_ptr piece = chessBoard_[newPosition.x_][newPosition.y_];
-            if (piece->getPieceType() == PieceType::KNIGHT && piece->getColor() != kingColor) {
+            Piece piece = chessBoard_[newPosition.x_][newPosition.y_];
+            if (piece.getPieceType() == PieceType::KNIGHT && piece.getColor() != kingColor) {
                 checkingPiece = newPosition;
                 return true;
             }
@@ -704,16 +1581,15 @@ bool Chess::isCheckedByKnight(Color kingColor, Position &checkingPiece) {
 bool Chess::isCheckedByPawn(Color kingColor, Position &checkingPiece) {
     Position newPosition;
     Position myKingPosition = this->myKingPosition(kingColor);
-    std::vector<Vector2D> captureMoves = (kingColor == Color::WHITE) ? PawnWhite::getCaptureMoves() :
-                                         PawnBlack::getCaptureMoves();
+    std::span<const Vector2D> captureMoves = Pawn::getCaptureMoves(kingColor);
 
     for (const auto &captureMove : captureMoves) {
         newPosition = myKingPosition + captureMove;
         if (onChessboard(newPosition) && !isFree(newPosition)) {
 
             // if there is a pawn of the opposite color
-            piece_ptr piece = chessBoard_[newPosition.x_][newPosition.y_];
-            if (piece->getPieceType() == PieceType::PAWN && piece->getColor() != kingColor) {
+            Piece piece = chessBoard_[newPosition.x_][newPosition.y_];
+            if (piece.getPieceType() == PieceType::PAWN && piece.getColor() != kingColor) {
                 checkingPiece = newPosition;
                 return true;
             }
@@ -734,7 +1610,7 @@ bool Chess::isCheckedByPawn(Color kingColor, Position &checkingPiece) {
  */
 bool Chess::hasBlockAbleCheck(Color kingColor, int &checkCount, Position &checkingPiece) {
     Position myKingPosition = this->myKingPosition(kingColor);
-    std::vector<Vector2D> kingMoves = King::getVectorMoves();
+    std::span<const Vector2D> kingMoves = King::getVectorMoves();
     Position newPosition;
 
     for (const auto &move : kingMoves) {
@@ -746,10 +1622,10 @@ bool Chess::hasBlockAbleCheck(Color kingColor, int &checkCount, Position &checki
         }
         // if there is a piece on the way, and it is an enemy piece
         if (Chess::onChessboard(newPosition) && isEnemy(newPosition, kingColor)) {
-            piece_ptr piece = chessBoard_[newPosition.x_][newPosition.y_];
+            Piece piece = chessBoard_[newPosition.x_][newPosition.y_];
 
             // if the piece can block the check => it is queen, rook or bishop
-            if (piece->isCheckBlockAble() && canMoveDirection(piece, move)) {
+            if (piece.isCheckBlockAble() && piece.canMoveDirection(move)) {
                 checkingPiece = newPosition;
                 checkCount++;
             }
@@ -765,8 +1641,7 @@ bool Chess::hasBlockAbleCheck(Color kingColor, int &checkCount, Position &checki
  * @param moves empty vector of moves -> will be filled by moves that can block check
  * @return true if king is checked by enemy
  */
-bool Chess::needsToBlockCheck(Color colorOnMove, std::vector<piece_move> &moves) {
-    std::vector<Position> positions;
+bool Chess::needsToBlockCheck(Color colorOnMove, move_list &moves) {
     Position checkingPiece;
     int blockAble = 0;
     int unblockAble = 0;
@@ -799,10 +1674,9 @@ bool Chess::needsToBlockCheck(Color colorOnMove, std::vector<piece_move> &moves)
  * @param kingColor color of king
  * @param moves vector of moves -> will be filled by possible moves of king
  */
-void Chess::addKingMoves(Color kingColor, std::vector<piece_move> &moves) {
+void Chess::addKingMoves(Color kingColor, move_list &moves) {
     Position myKingPosition = this->myKingPosition(kingColor);
-    std::vector<Position> positions = (kingColor == Color::WHITE) ? whiteKing_->getPossibleMoves(*this) :
-                                                                    blackKing_->getPossibleMoves(*this);
+    position_list positions = King::getPossibleMoves(*this, myKingPosition, kingColor);
 
     for (const auto &position : positions) {
         moves.emplace_back(myKingPosition, position);
@@ -816,17 +1690,16 @@ void Chess::addKingMoves(Color kingColor, std::vector<piece_move> &moves) {
  * @param enemyCheckingPiece position of enemy checking piece
  * @param moves vector of moves -> will be filled by possible moves of pieces of given color
  */
-void Chess::addMovesAtPosition(Color colorOnMove, const Position &enemyCheckingPiece, std::vector<piece_move> &moves) {
-    std::vector<Position> positions;
-
-    for (const auto &piece : getPieces(colorOnMove)) {
-        if (piece->getPieceType() != PieceType::KING) {
-            positions = piece->getPossibleMoves(*this);
+void Chess::addMovesAtPosition(Color colorOnMove, const Position &enemyCheckingPiece, move_list &moves) {
+    for (const Position &piecePosition : getPieces(colorOnMove)) {
+        Piece piece = chessBoard_[piecePosition.x_][piecePosition.y_];
+        if (piece.getPieceType() != PieceType::KING) {
+            position_list positions = piece.getPossibleMoves(*this, piecePosition);
 
             // if the piece can updatePosition to the position of the checking piece => add it to the moves
             for (const auto & position : positions) {
                 if (position == enemyCheckingPiece) {
-                    moves.emplace_back(piece->getPosition(), position);
+                    moves.emplace_back(piecePosition, position);
                 }
             }
         }
@@ -840,9 +1713,9 @@ void Chess::addMovesAtPosition(Color colorOnMove, const Position &enemyCheckingP
  * @param checkingPiece position of enemy checking piece
  * @param moves vector of moves -> will be filled by possible moves of pieces of player´s color
  */
-void Chess::addMovesAtPositionAndBetween(Color myColor, const Position &checkingPiece, std::vector<piece_move> &moves) {
+void Chess::addMovesAtPositionAndBetween(Color myColor, const Position &checkingPiece, move_list &moves) {
     // add moves at the position of the checking piece
-    std::vector<Position> blockPositions;
+    position_list blockPositions(scratch());
     blockPositions.push_back(checkingPiece);
 
     // get vector between the checking piece and my king
@@ -857,15 +1730,15 @@ void Chess::addMovesAtPositionAndBetween(Color myColor, const Position &checking
         newPosition += vector;
     }
 
-    std::vector<Position> possibleMoves;
-    for (const auto &piece : getPieces(myColor)) {
-        if (piece->getPieceType() != PieceType::KING) {
-            possibleMoves = piece->getPossibleMoves(*this);
+    for (const Position &piecePosition : getPieces(myColor)) {
+        Piece piece = chessBoard_[piecePosition.x_][piecePosition.y_];
+        if (piece.getPieceType() != PieceType::KING) {
+            position_list possibleMoves = piece.getPossibleMoves(*this, piecePosition);
 
             // if the piece can move to the check blocking position => add updatePosition
             for (const auto &position : possibleMoves) {
                 if (std::find(blockPositions.begin(), blockPositions.end(), position) != blockPositions.end()) {
-                    moves.emplace_back(piece->getPosition(), position);
+                    moves.emplace_back(piecePosition, position);
                 }
             }
         }
@@ -895,10 +1768,10 @@ void Chess::printBoard(const std::string &fileName) {
  * @param outputStream output stream to print to
  */
 void Chess::printBoard(std::ostream &os) const {
-    for (const auto & row : chessBoard_) {
-        for (const auto & piece : row) {
-            if (piece != nullptr) {
-                os << *piece;
+    for (int x = 0; x < 8; ++x) {
+        for (int y = 0; y < 8; ++y) {
+            if (!chessBoard_[x][y].isEmpty()) {
+                chessBoard_[x][y].print(os, Position(x, y));
             }
         }
     }
@@ -911,6 +1784,7 @@ void Chess::printBoard(std::ostream &os) const {
  * @return true if move will give check
  */
 int Chess::willBeCheckBonus(const piece_move &move) {
+    TRACE_SCOPE("checkBonus");
     Position positionFrom = move.first;
     Position positionTo = move.second;
 
@@ -921,23 +1795,23 @@ int Chess::willBeCheckBonus(const piece_move &move) {
     int bonus = 0;
 
     // create piece backups -> at positionFrom might be pawn which will be promoted to queen, rook, etc.
-    piece_ptr pieceBackupFrom = chessBoard_[fromX][fromY];
-    piece_ptr pieceBackupTo = chessBoard_[toX][toY];
-    Color pieceColor = pieceBackupFrom->getColor();
+    Piece pieceBackupFrom = chessBoard_[fromX][fromY];
+    Piece pieceBackupTo = chessBoard_[toX][toY];
+    Color pieceColor = pieceBackupFrom.getColor();
 
     // check whether piece blocks own color check
-    std::vector<Position> blockingPositions;
+    position_list blockingPositions(scratch());
     bool inspectBlockedCheck = pieceBlocksCheck(positionFrom, getOppositeColor(pieceColor), blockingPositions);
 
     // updatePosition piece
     movePiece(move);
 
     // get bonus for giving check
-    bonus += givesCheckBonus(chessBoard_[toX][toY]);
+    bonus += givesCheckBonus(positionTo);
     if (inspectBlockedCheck) {
         // at the last check-blocking position is the checking piece
         Position position = blockingPositions.back();
-        bonus += givesCheckBonus(chessBoard_[position.x_][position.y_]);
+        bonus += givesCheckBonus(position);
     }
 
     // updatePosition piece back
@@ -951,18 +1825,21 @@ int Chess::willBeCheckBonus(const piece_move &move) {
 /**
  * @brief setup minimax, if parameter is not specified by user, default value will be used
  * @param searchDepth number of one color moves to check in minimax
- * @param addCheckmateMoves if true, checkmate moves will be added to checkMateList_
- * @param pruningSize number of moves to consider in minimax
+ * @param addCheckmateMoves if true, mating line will be added to checkMateList_
+ * @param pruningPolicy number of moves to consider for attacker and defender
  */
-void Chess::setupMinimax(size_t searchDepth, bool addCheckmateMoves, size_t pruningSize) {
+void Chess::setupMinimax(size_t searchDepth, bool addCheckmateMoves, const PruningPolicy &pruningPolicy) {
     searchDepth_ = 2 * searchDepth;
     addCheckmateMoves_ = addCheckmateMoves;
-    pruningSize_ = pruningSize;
-
-    if (pruningSize_ != PRUNING_SIZE) {
-        std::cout << "You have defined pruning size, only limited number of moves will be searched." << std::endl;
-        std::cout << "This can lead to invalid results in some cases." << std::endl;
-        std::cout << std::endl;
-    }
+    pruningPolicy_ = pruningPolicy;
+    checkMateList_.clear();
+    pvTable_.resize((searchDepth_ + 1) * (searchDepth_ + 1));
+    pvLength_.assign(searchDepth_ + 1, 0);
+    searchStats_.reset();
+    bestStartingMove_ = piece_move();
+    searchStatus_ = SearchStatus::COMPLETED;
+    attackerPruned_ = false;
+    defenderPruned_ = false;
+    refutations_.resize(searchDepth_);
 }
 
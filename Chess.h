@@ -4,6 +4,8 @@
 #include <fstream>
 #include <sstream>
 #include <climits>
+#include <cstdint>
+#include <unordered_map>
 #include "pieces/Piece.h"
 #include "pieces/King.h"
 #include "pieces/Queen.h"
@@ -11,21 +13,40 @@
 #include "pieces/Bishop.h"
 #include "pieces/Knight.h"
 #include "pieces/Pawn.h"
-#include "pieces/PawnWhite.h"
-#include "pieces/PawnBlack.h"
 #include "Exception.h"
-
-using piece_ptr = std::shared_ptr<Piece>;
-using piece_move = std::pair<Position, Position>;
-using piece_moves = std::vector<piece_move>;
+#include "MateSolutions.h"
+#include "PruningPolicy.h"
+#include "Reporter.h"
+#include "SearchLimits.h"
+#include "SearchResult.h"
+#include "SearchStats.h"
+#include "PerftTable.h"
+#include "SearchArena.h"
+#include "SolutionCache.h"
+#include "Tablebase.h"
+
+using move_backup = std::pair<Piece, Piece>;                 ///< Pieces at start and end of move before it was done
+using mate_memo = std::unordered_map<std::uint64_t, size_t>;  ///< Number of mating lines by position hash
 
 // check bonus
 static const size_t GIVES_CHECK_BONUS = 5;      ///< Bonus for giving check
 
+// checkmate scores -> checkmate at ply p is CHECKMATE_SCORE - p for white, quicker checkmate is better
+static const int CHECKMATE_SCORE = INT_MAX - 1;  ///< Score of checkmate at root, INT_MAX/INT_MIN are search bounds
+static const int MAX_CHECKMATE_PLY = 1024;       ///< Maximal ply of checkmate, scores closer to zero are not checkmate
+
+// static exchange evaluation
+static const int SEE_KING_VALUE = 100;          ///< Value of king in exchange, king cannot be recaptured
+static const size_t SEE_MAX_EXCHANGES = 32;     ///< Maximal number of captures on one square
+
 // minimax settings
-static const size_t PRUNING_SIZE = INT_MAX;     ///< Number of best moves to consider in minimax
 static const size_t SEARCH_DEPTH = 3;           ///< Number of moves to search in minimax
-static const bool ADD_CHECKMATE_MOVES = false;  ///< Add checkmate moves to the list
+static const bool ADD_CHECKMATE_MOVES = false;  ///< Add mating line to the list
+static const bool VERIFY_PRUNING = false;       ///< Verify pruned results by full-width re-search
+
+// late move reductions
+static const size_t LMR_FULL_DEPTH_MOVES = 3;   ///< Number of attacker moves searched with full depth
+static const size_t LMR_REDUCTION = 0;          ///< Number of moves to reduce quiet late attacker moves, 0 = disabled
 
 
 /**
@@ -33,19 +54,48 @@ static const bool ADD_CHECKMATE_MOVES = false;  ///< Add checkmate moves to the
  */
 class Chess {
 private:
-    piece_ptr chessBoard_[8][8];  ///< 2D array representing the chess board
-    piece_ptr whiteKing_;         ///< White king on the board
-    piece_ptr blackKing_;         ///< Black king on the board
+    Piece chessBoard_[8][8];        ///< 2D array representing the chess board
+    Position whiteKingPosition_;    ///< Position of white king, invalid if there is none
+    Position blackKingPosition_;    ///< Position of black king, invalid if there is none
 
     // moves
     piece_move bestStartingMove_;             ///< Best updatePosition for the computer
     piece_moves minimaxMoves_;                ///< Vector of moves searched in minimax tree
-    std::vector<piece_moves> checkMateList_;  ///< Vector of vector off pairs positions leading to dealCheckmateFound
+    std::vector<piece_moves> checkMateList_;  ///< Principal mating line of last search if requested
+
+    // principal variation -> row ply holds best line from node at ply, rows have searchDepth_ + 1 moves
+    piece_moves pvTable_;           ///< Triangular table of best lines stored in one array
+    std::vector<size_t> pvLength_;  ///< End of best line in each row of pvTable_
 
     // minimax settings
     size_t searchDepth_ = 2 * SEARCH_DEPTH;         ///< User search depth
-    size_t pruningSize_ = PRUNING_SIZE;             ///< Search depth
-    bool addCheckmateMoves_ = ADD_CHECKMATE_MOVES;  ///< Add checkmate moves to the list
+    PruningPolicy pruningPolicy_;                   ///< Number of moves to consider for each player
+    bool addCheckmateMoves_ = ADD_CHECKMATE_MOVES;  ///< Add mating line to the list
+
+    // pruning verification
+    Color attackerColor_ = Color::WHITE;  ///< Color trying to give checkmate
+    bool fullWidthDefender_ = false;      ///< Do not prune moves of defending color
+    bool attackerPruned_ = false;         ///< Some attacker moves were cut off in last search
+    bool defenderPruned_ = false;         ///< Some defender moves were cut off in last search
+
+    // late move reductions
+    size_t lmrFullDepthMoves_ = LMR_FULL_DEPTH_MOVES;  ///< Number of attacker moves searched with full depth
+    size_t lmrReduction_ = LMR_REDUCTION;              ///< Number of moves to reduce quiet late attacker moves
+
+    // defender move ordering
+    piece_move counterMoves_[64][64];      ///< Defender move which refuted attacker move [from square][to square]
+    std::vector<piece_move> refutations_;  ///< Defender move which caused the last cutoff at ply
+
+    SearchStats searchStats_;                 ///< Statistics of last search
+    SearchReporter *reporter_ = nullptr;      ///< Reports progress and results of search, nullptr = silent
+    SolutionCache *solutionCache_ = nullptr;  ///< Results of previous searches, nullptr = no cache
+    const Tablebases *tablebases_ = nullptr;  ///< Endgame tables probed by minimax, nullptr = no tables
+    PerftTable *perftTable_ = nullptr;        ///< Counts of perft subtrees, nullptr = no hashing
+    mutable SearchArena arena_;               ///< Scratch memory of move and position lists, rewound by each node
+
+    // interruption
+    SearchLimits searchLimits_;                            ///< Node budget, deadline and stop flag of search
+    SearchStatus searchStatus_ = SearchStatus::COMPLETED;  ///< How the last search ended
 
 
 public:
@@ -67,6 +117,15 @@ public:
     }
 
 
+    /**
+     * @brief Get memory resource of scratch lists, lists allocated during search are freed when search node returns
+     * @return arena of search inside minimax or perft, default resource otherwise
+     */
+    std::pmr::memory_resource *scratch() const {
+        return arena_.scratch();
+    }
+
+
     /**
      * @brief Check if given position is free
      * @param position position to check
@@ -75,7 +134,7 @@ public:
     bool isFree(const Position &position) const {
         int x = position.x_;
         int y = position.y_;
-        return chessBoard_[x][y] == nullptr;
+        return chessBoard_[x][y].isEmpty();
     }
 
 
@@ -97,7 +156,7 @@ public:
      * @param positions empty vector of positions to fill by positions which might be check-blocking
      * @return true if piece blocks check
      */
-    bool pieceBlocksCheck(const Position &piecePosition, Color kingColor, std::vector<Position> &positions) const;
+    bool pieceBlocksCheck(const Position &piecePosition, Color kingColor, position_list &positions) const;
 
 
     /**
@@ -109,7 +168,7 @@ public:
     bool isEnemy(const Position &position, Color myColor) const {
         int x = position.x_;
         int y = position.y_;
-        return chessBoard_[x][y]->getColor() != myColor;
+        return chessBoard_[x][y].getColor() != myColor;
     }
 
 
@@ -119,7 +178,7 @@ public:
      * @return A constant reference to the position of the player's own king.
      */
     const Position &myKingPosition(Color myColor) const {
-        return myColor == Color::WHITE ? whiteKing_->getPosition() : blackKing_->getPosition();
+        return myColor == Color::WHITE ? whiteKingPosition_ : blackKingPosition_;
     }
 
 
@@ -129,7 +188,7 @@ public:
      * @return A constant reference to the position of the enemy's king.
      */
     const Position &enemyKingPosition(Color myColor) const {
-        return myColor != Color::WHITE ? whiteKing_->getPosition() : blackKing_->getPosition();
+        return myColor != Color::WHITE ? whiteKingPosition_ : blackKingPosition_;
     }
 
 
@@ -138,8 +197,8 @@ public:
      * @return True if kings neighbor
      */
     bool kingsAreNeighbours() const {
-        Position whitePosition = whiteKing_->getPosition();
-        Position blackPosition = blackKing_->getPosition();
+        const Position &whitePosition = whiteKingPosition_;
+        const Position &blackPosition = blackKingPosition_;
         return (abs(blackPosition.x_ - whitePosition.x_) <= 1 && abs(blackPosition.y_ - whitePosition.y_) <= 1);
     }
 
@@ -167,6 +226,105 @@ public:
     void validateKings();
 
 
+    /**
+     * @brief Remove all pieces from the chessboard, so another game can be loaded.
+     */
+    void clearGame();
+
+
+    /**
+     * @brief Forget counter moves and refutations learned by previous searches, so the next search visits the same
+     * nodes as the first search of new Chess
+     */
+    void clearMoveOrdering();
+
+
+    /**
+     * @brief Set reporter of search progress and results, search prints nothing without reporter
+     * @param reporter reporter to use, nullptr disables reporting, reporter has to outlive searches
+     */
+    void setReporter(SearchReporter *reporter) {
+        reporter_ = reporter;
+    }
+
+
+    /**
+     * @brief Set cache consulted by findCheckMate before searching, exact results of finished searches are stored
+     * @param solutionCache cache to use, nullptr disables caching, cache has to outlive searches
+     */
+    void setSolutionCache(SolutionCache *solutionCache) {
+        solutionCache_ = solutionCache;
+    }
+
+
+    /**
+     * @brief Set endgame tables probed by minimax when few pieces remain
+     * @param tablebases tables to probe, nullptr disables probing, tables have to outlive searches
+     */
+    void setTablebases(const Tablebases *tablebases) {
+        tablebases_ = tablebases;
+    }
+
+
+    /**
+     * @brief Set hash table reusing counts of transposed perft subtrees
+     * @param perftTable table shared by threads, nullptr disables hashing, table has to outlive perft calls
+     */
+    void setPerftTable(PerftTable *perftTable) {
+        perftTable_ = perftTable;
+    }
+
+
+    /**
+     * @brief Look up current position in endgame tables
+     * @param colorOnMove color of player on move
+     * @return entry from view of colorOnMove, empty if there are more pieces or no table of the material
+     */
+    std::optional<std::uint8_t> probeTablebases(Color colorOnMove) const;
+
+
+    /**
+     * @brief Set limits of following searches, interrupted search returns as soon as possible with the best
+     * information found so far
+     * @param searchLimits node budget, deadline and stop flag
+     */
+    void setSearchLimits(const SearchLimits &searchLimits) {
+        searchLimits_ = searchLimits;
+    }
+
+
+    /**
+     * @brief Check how the last search ended
+     * @return COMPLETED if search finished, otherwise the reason why it was interrupted
+     */
+    SearchStatus getSearchStatus() const {
+        return searchStatus_;
+    }
+
+
+    /**
+     * @brief Check if running search should be interrupted, deadline and stop flag are polled every pollInterval nodes
+     * @return true if search has to be interrupted
+     */
+    bool searchInterrupted();
+
+
+    /**
+     * @brief Play move given in coordinate notation (e.g. e2e4, e7e8q), move has to be legal
+     * @param notation move in coordinate notation
+     * @param colorOnMove color of player on move
+     */
+    void playMove(const std::string &notation, Color colorOnMove);
+
+
+    /**
+     * @brief Play castling or en passant, minimax does not generate these moves but they can appear in played games
+     * @param notation move in coordinate notation
+     * @param colorOnMove color of player on move
+     */
+    void playSpecialMove(const std::string &notation, Color colorOnMove);
+
+
     /**
      * @brief Check if a given position is occupied by the enemy's king.
      * @param position The position to check.
@@ -199,6 +357,13 @@ public:
     void loadFENGame(const std::string &FENCode);
 
 
+    /**
+     * @brief Get piece placement of current position in FEN format, it can be loaded by loadFENGame
+     * @return FEN code of game
+     */
+    std::string getFENCode() const;
+
+
     /**
      * @brief load color of piece
      * @param color string color of piece
@@ -228,12 +393,87 @@ public:
       * @brief Check if color can give checkmate in searchDepth moves
       * @param colorOnMove color of player on move
       * @param searchDepth number of one color moves to check in minimax
-      * @param addCheckMateMoves if true, checkmate moves will be add checkMateList_
+      * @param addCheckMateMoves if true, mating line will be added to checkMateList_
       * @param pruningSize number of moves to consider in minimax
-      * @return true if colorOnMove can give checkmate in searchDepth moves
+      * @param verifyPruning if true, pruned results are verified by re-search and widened until they are sound
+      * @return result of search, converts to true if colorOnMove can give checkmate in searchDepth moves
       */
-    bool findCheckMate(Color colorOnMove, size_t searchDepth = SEARCH_DEPTH, bool addCheckMateMoves = ADD_CHECKMATE_MOVES,
-                       size_t pruningSize = PRUNING_SIZE);
+    SearchResult findCheckMate(Color colorOnMove, size_t searchDepth = SEARCH_DEPTH,
+                               bool addCheckMateMoves = ADD_CHECKMATE_MOVES, size_t pruningSize = PRUNING_SIZE,
+                               bool verifyPruning = VERIFY_PRUNING);
+
+
+    /**
+     * @brief Check if color can give checkmate in searchDepth moves, moves are pruned by pruning policy
+     * @param colorOnMove color of player on move
+     * @param searchDepth number of one color moves to check in minimax
+     * @param addCheckMateMoves if true, mating line will be added to checkMateList_
+     * @param pruningPolicy number of moves to consider for attacker and defender
+     * @return result of search, converts to true if colorOnMove can give checkmate in searchDepth moves
+     */
+    SearchResult findCheckMate(Color colorOnMove, size_t searchDepth, bool addCheckMateMoves,
+                               const PruningPolicy &pruningPolicy);
+
+
+    /**
+     * @brief Run minimax with pruningPolicy_ and make the result sound. Checkmate found with pruned defender moves is
+     * verified by re-search with all defender moves. If attacker moves were pruned and no checkmate or a checkmate in
+     * more than one move is found, policy is widened and search repeated, because pruned attacker moves could give a
+     * shorter one.
+     * @param colorOnMove color of player on move
+     * @return value of best move, same as full-width minimax
+     */
+    int verifiedMinimax(Color colorOnMove);
+
+
+    /**
+     * @brief Check if result of last search is the same as result of full-width search, so it can be cached
+     * @param result result of last search
+     * @return true if result is exact
+     */
+    bool isExactResult(const SearchResult &result) const;
+
+
+    /**
+     * @brief Check if evaluation returned by minimax means checkmate
+     * @param evaluation evaluation of game position
+     * @return true if evaluation means checkmate
+     */
+    static bool isCheckMateEvaluation(int evaluation) {
+        return evaluation > CHECKMATE_SCORE - MAX_CHECKMATE_PLY || evaluation < MAX_CHECKMATE_PLY - CHECKMATE_SCORE;
+    }
+
+
+    /**
+     * @brief Check if evaluation returned by minimax means checkmate given by attacker of current search
+     * @param evaluation evaluation of game position
+     * @return true if attacker gives checkmate, false for checkmate of attacker
+     */
+    bool isAttackerCheckMate(int evaluation) const {
+        return isCheckMateEvaluation(evaluation) && (evaluation > 0) == (attackerColor_ == Color::WHITE);
+    }
+
+
+    /**
+     * @brief Get score of checkmate for white
+     * @param matedColor color of mated king
+     * @param ply number of half-moves from the root of minimax to checkmate
+     * @return positive score if black is mated, negative if white is mated, later checkmate is closer to zero
+     */
+    static int checkMateScore(Color matedColor, size_t ply) {
+        int score = CHECKMATE_SCORE - static_cast<int>(ply);
+        return (matedColor == Color::BLACK) ? score : -score;
+    }
+
+
+    /**
+     * @brief Get number of half-moves from the root of minimax to checkmate
+     * @param evaluation checkmate evaluation
+     * @return ply of checkmate
+     */
+    static size_t checkMatePly(int evaluation) {
+        return CHECKMATE_SCORE - std::abs(evaluation);
+    }
 
 
     /**
@@ -247,6 +487,24 @@ public:
     int minimax(Color colorOnMove, size_t searchDepth, int alpha = INT_MIN, int beta = INT_MAX);
 
 
+    /**
+     * @brief Evaluate position by endgame tables -> checkmate is exact if it fits to remaining depth, other positions
+     * are evaluated statically, because minimax cannot find checkmate there
+     * @param colorOnMove color of player on move
+     * @param searchDepth remaining search depth
+     * @return value of position, empty if position is not in tables
+     */
+    std::optional<int> tablebaseEvaluation(Color colorOnMove, size_t searchDepth);
+
+
+    /**
+     * @brief Extend mating line which ends in tablebase position by optimal moves from tables until checkmate
+     * @param line mating line starting in current position
+     * @param colorOnMove color of player on move in current position
+     */
+    void completeMatingLine(piece_moves &line, Color colorOnMove);
+
+
     /**
      * @brief Find best move for maximizing player == white
      * @param searchDepth search depth
@@ -267,6 +525,38 @@ public:
     int minimizer(size_t searchDepth, int alpha, int beta);
 
 
+    /**
+     * @brief Get depth reduction for late quiet attacker move, reduction is in whole moves so the same color is on
+     * move at the end of search
+     * @param colorOnMove color of player on move
+     * @param searchDepth search depth
+     * @param moveNumber index of move in ordered moves
+     * @param move move to reduce
+     * @return number of half-moves to reduce, 0 if move is searched with full depth
+     */
+    size_t lateMoveReduction(Color colorOnMove, size_t searchDepth, size_t moveNumber, const piece_move &move);
+
+
+    /**
+     * @brief Check if move is quiet -> it does not capture (losing captures are quiet), give check or promote pawn
+     * @param move move to check
+     * @return true if move is quiet
+     */
+    bool isQuietMove(const piece_move &move);
+
+
+    /**
+     * @brief Set late move reductions of quiet attacker moves. Quiet late moves are searched with reduced depth first
+     * and searched again with full depth only if they fail high.
+     * @param fullDepthMoves number of first attacker moves which are never reduced
+     * @param reduction number of moves to reduce, 0 disables reductions
+     */
+    void setLateMoveReductions(size_t fullDepthMoves, size_t reduction) {
+        lmrFullDepthMoves_ = fullDepthMoves;
+        lmrReduction_ = reduction;
+    }
+
+
     /**
      * @brief Move piece on chessboard
      * @param move move to do
@@ -275,19 +565,146 @@ public:
 
 
     /**
-     * @brief Get all pieces of color
+     * @brief Do move which will be taken back by undoMove
+     * @param move move to do
+     * @return pieces needed to take the move back
+     */
+    move_backup makeMove(const piece_move &move) {
+        move_backup backup(chessBoard_[move.first.x_][move.first.y_], chessBoard_[move.second.x_][move.second.y_]);
+        movePiece(move);
+        return backup;
+    }
+
+
+    /**
+     * @brief Take back move done by makeMove -> make reverse move and restore both pieces (pawn might be promoted)
+     * @param move move to take back
+     * @param backup pieces returned by makeMove
+     */
+    void undoMove(const piece_move &move, const move_backup &backup) {
+        chessBoard_[move.second.x_][move.second.y_] = backup.first;
+        movePiece({move.second, move.first});
+        chessBoard_[move.second.x_][move.second.y_] = backup.second;
+    }
+
+
+    /**
+     * @brief Get Zobrist hash of position, positions with the same pieces and the same player on move have the same
+     * hash (there is no castling or en passant in the engine)
+     * @param colorOnMove color of player on move
+     * @return hash of position
+     */
+    std::uint64_t positionHash(Color colorOnMove) const;
+
+
+    /**
+     * @brief Find all attacker first moves which force checkmate in searchDepth moves and count all mating lines.
+     * Positions are memoized by hash and remaining depth, so transposed lines are solved once.
+     * @param colorOnMove color of attacker on move
+     * @param searchDepth number of attacker moves
+     * @param countLines if false, only mating first moves are found, which is faster
+     * @return mating first moves and number of mating lines
+     */
+    MateSolutions findAllCheckMates(Color colorOnMove, size_t searchDepth, bool countLines = true);
+
+
+    /**
+     * @brief Count leaf nodes of legal move tree, moves are generated by getAllMoves and done by makeMove, counts of
+     * subtrees are reused from perft table if it is set
+     * @param colorOnMove color of player on move
+     * @param depth number of half-moves
+     * @return number of positions reached after depth half-moves
+     */
+    size_t perft(Color colorOnMove, size_t depth);
+
+
+    /**
+     * @brief Count leaf nodes of legal move tree separately for each root move
+     * @param colorOnMove color of player on move
+     * @param depth number of half-moves including root move, at least 1
+     * @return root moves in generation order with number of positions reached after each of them
+     */
+    std::vector<std::pair<piece_move, size_t>> divide(Color colorOnMove, size_t depth);
+
+
+    /**
+     * @brief Count mating lines with attacker on move
+     * @param attacker color of attacker
+     * @param searchDepth number of attacker moves left
+     * @param countLines if false, 1 is returned for any number of lines
+     * @param memo solved positions for each number of moves left
+     * @param solutions statistics to update
+     * @return number of mating lines, 0 if attacker cannot force checkmate
+     */
+    size_t countAttackerLines(Color attacker, size_t searchDepth, bool countLines, std::vector<mate_memo> &memo,
+                              MateSolutions &solutions);
+
+
+    /**
+     * @brief Count mating lines with defender on move, each defender move has to lose
+     * @param defender color of defender
+     * @param searchDepth number of attacker moves left, including the move which was just played
+     * @param countLines if false, 1 is returned for any number of lines
+     * @param memo solved positions for each number of moves left
+     * @param solutions statistics to update
+     * @return number of mating lines, 0 if some defender move avoids checkmate
+     */
+    size_t countDefenderLines(Color defender, size_t searchDepth, bool countLines, std::vector<mate_memo> &memo,
+                              MateSolutions &solutions);
+
+
+    /**
+     * @brief Get positions of all pieces of color in board order
      * @param color color if pieces to get
-     * @return vector of pieces
+     * @return vector of piece positions
      */
-    std::vector<piece_ptr> getPieces(Color color) const;
+    position_list getPieces(Color color) const;
 
 
     /**
      * @brief Get best moves for color -> they are chosen using quickEvaluation
      * @param color color of player on move
+     * @param ply number of half-moves from the root of minimax
      * @return vector of best moves
      */
-    std::vector<piece_move> getBestMoves(Color color);
+    move_list getBestMoves(Color color, size_t ply = 0);
+
+
+    /**
+     * @brief Move counter move of previous attacker move to the first place and refutation at ply to the second place
+     * @param scoredMoves defender moves with their quick evaluation
+     * @param ply number of half-moves from the root of minimax
+     */
+    void orderRefutations(std::pmr::vector<std::pair<int, piece_move>> &scoredMoves, size_t ply) const;
+
+
+    /**
+     * @brief Save defender move which caused cutoff -> attacker move before it was refuted
+     * @param colorOnMove color of player who made the move
+     * @param ply number of half-moves from the root of minimax
+     * @param move move which caused cutoff
+     */
+    void storeRefutation(Color colorOnMove, size_t ply, const piece_move &move);
+
+
+    /**
+     * @brief Get defender move which refuted attacker move last time
+     * @param attackerMove attacker move
+     * @return counter move, pair of invalid positions if there is none
+     */
+    const piece_move &getCounterMove(const piece_move &attackerMove) const {
+        return counterMoves_[squareIndex(attackerMove.first)][squareIndex(attackerMove.second)];
+    }
+
+
+    /**
+     * @brief Get index of position on the chessboard
+     * @param position position on the chessboard
+     * @return index from 0 to 63
+     */
+    static size_t squareIndex(const Position &position) {
+        return 8 * position.x_ + position.y_;
+    }
 
 
     /**
@@ -295,7 +712,7 @@ public:
      * @param color color of player on move
      * @return vector of all moves
      */
-    std::vector<piece_move> getAllMoves(Color color);
+    move_list getAllMoves(Color color);
 
 
     /**
@@ -311,14 +728,58 @@ public:
      * @param position position to move
      * @return value of captured piece or 0 if no piece is captured
      */
-    int captureEnemyBonus(const Position &position) {
+    int captureEnemyBonus(const Position &position) const {
         if (!isFree(position)) {
-            return chessBoard_[position.x_][position.y_]->getValue();
+            return chessBoard_[position.x_][position.y_].getValue();
         }
         return 0;
     };
 
 
+    /**
+     * @brief bonus for capturing enemy piece, losing captures get result of static exchange evaluation
+     * @param move move to evaluate
+     * @return value of captured piece, negative value of losing capture or 0 if no piece is captured
+     */
+    int captureExchangeBonus(const piece_move &move) const {
+        if (isFree(move.second)) {
+            return 0;
+        }
+        int exchange = staticExchangeEvaluation(move);
+        return (exchange < 0) ? exchange : captureEnemyBonus(move.second);
+    };
+
+
+    /**
+     * @brief static exchange evaluation -> material balance after all captures on target square of move, each
+     * player captures with the least valuable piece and can stop capturing when it is not profitable
+     * @param move capturing move to evaluate
+     * @return material won (positive) or lost (negative) by player making the move
+     */
+    int staticExchangeEvaluation(const piece_move &move) const;
+
+
+    /**
+     * @brief find the least valuable piece of color attacking target, pieces hidden behind removed pieces (x-rays)
+     * are also found
+     * @param target attacked position
+     * @param color color of attacking pieces
+     * @param removed positions of pieces which already captured on target
+     * @return position of the least valuable attacker, invalid position if there is no attacker
+     */
+    Position leastValuableAttacker(const Position &target, Color color, const bool removed[8][8]) const;
+
+
+    /**
+     * @brief get value of piece used in static exchange evaluation
+     * @param piece piece to evaluate
+     * @return value of piece, king has SEE_KING_VALUE
+     */
+    static int exchangeValue(Piece piece) {
+        return piece.getPieceType() == PieceType::KING ? SEE_KING_VALUE : piece.getValue();
+    }
+
+
     /**
      * @brief bonus for moving piece to better position, we prefer positions closer to enemy king
      * @param move move to evaluate
@@ -359,24 +820,25 @@ public:
     /**
      * @brief evaluate piece based on its value and number of possible moves, method called by deepEvaluation
      * @param piece piece to evaluate
+     * @param position position of piece
      * @return value of piece
      */
-    int evaluatePiece(const piece_ptr &piece) {
+    int evaluatePiece(Piece piece, const Position &position) {
         int value = 0;
-        value += piece->getValue();
-        value += piece->getPossibleMoves(*this).size();
+        value += piece.getValue();
+        value += piece.getPossibleMoves(*this, position).size();
 
-        return (piece->getColor() == Color::WHITE) ? value : value * -1;
+        return (piece.getColor() == Color::WHITE) ? value : value * -1;
     }
 
 
     /**
      * @brief bonus for giving check
-     * @param piece piece to evaluate
+     * @param position position of piece to evaluate
      * @return GIVES_CHECK_BONUS if piece gives check, 0 otherwise
      */
-    int givesCheckBonus(const piece_ptr &piece) const {
-        if (piece->givesCheck(*this)) {
+    int givesCheckBonus(const Position &position) const {
+        if (chessBoard_[position.x_][position.y_].givesCheck(*this, position)) {
             return GIVES_CHECK_BONUS;
         }
         return 0;
@@ -384,23 +846,12 @@ public:
 
 
     /**
-     * @brief deal situation when checkmate was found
-     */
-    void dealCheckmateFound() const;
-
-
-    /**
-     * @brief deal situation when checkmate was not found
-     * @param evaluation evaluation of game position
-     */
-    void dealCheckmateNotFound(int evaluation) const;
-
-
-    /**
-     * @brief print game analysis
-     * @param evaluation evaluation of game position
+     * @brief Create result of finished search
+     * @param evaluation value of best root move
+     * @param searchDepth number of one color moves searched
+     * @return result of search
      */
-    static void printGameAnalysis(int evaluation);
+    SearchResult createSearchResult(int evaluation, size_t searchDepth) const;
 
 
     /**
@@ -485,23 +936,13 @@ public:
     bool hasBlockAbleCheck(Color kingColor, int &checkCount, Position &checkingPiece);
 
 
-    /**
-     * @brief check that piece can move in given vector -> called always on pieces that have blockable
-     * check (queen, rook, bishop)
-     */
-    static bool canMoveDirection(const piece_ptr &piece, const Vector2D &vector) {
-        std::vector<Vector2D> pieceMoves = piece->getVectorMoves();
-        return std::find(pieceMoves.begin(), pieceMoves.end(), vector) != pieceMoves.end();
-    }
-
-
     /**
      * @brief check if king is checked by enemy
      * @param colorOnMove color of player on move
      * @param moves empty vector of moves -> will be filled by moves that can block check
      * @return true if king is checked by enemy
      */
-    bool needsToBlockCheck(Color colorOnMove, std::vector<piece_move> &moves);
+    bool needsToBlockCheck(Color colorOnMove, move_list &moves);
 
 
     /**
@@ -509,7 +950,7 @@ public:
      * @param kingColor color of king
      * @param moves vector of moves -> will be filled by possible moves of king
      */
-    void addKingMoves(Color kingColor, std::vector<piece_move> &moves);
+    void addKingMoves(Color kingColor, move_list &moves);
 
 
     /**
@@ -518,7 +959,7 @@ public:
      * @param enemyCheckingPiece position of enemy checking piece
      * @param moves vector of moves -> will be filled by possible moves of pieces of given color
      */
-    void addMovesAtPosition(Color colorOnMove, const Position &enemyCheckingPiece, std::vector<piece_move> &moves);
+    void addMovesAtPosition(Color colorOnMove, const Position &enemyCheckingPiece, move_list &moves);
 
 
     /**
@@ -527,22 +968,32 @@ public:
      * @param checkingPiece position of enemy checking piece
      * @param moves vector of moves -> will be filled by possible moves of pieces of player´s color
      */
-    void addMovesAtPositionAndBetween(Color myColor, const Position &checkingPiece, std::vector<piece_move> &moves);
+    void addMovesAtPositionAndBetween(Color myColor, const Position &checkingPiece, move_list &moves);
 
 
     /**
-     * @brief add current minimaxMoves_ to checkMateList_
+     * @brief Start empty best line of node at ply
+     * @param ply number of half-moves from the root of minimax
      */
-    void addCheckMateMove() {
-        checkMateList_.push_back(minimaxMoves_);
+    void clearPrincipalVariation(size_t ply) {
+        pvLength_[ply] = ply;
     }
 
 
     /**
-     * @brief clear checkMateList_ -> called if there is higher leaf in minimax which does not lead to checkmate
+     * @brief Set best line of node at ply to move followed by best line of its child
+     * @param ply number of half-moves from the root of minimax
+     * @param move new best move of node
+     */
+    void updatePrincipalVariation(size_t ply, const piece_move &move);
+
+
+    /**
+     * @brief Get best line from the root of last search
+     * @return moves of both players starting with best root move
      */
-    void resetCheckMateMove() {
-        checkMateList_.clear();
+    piece_moves getPrincipalVariation() const {
+        return {pvTable_.begin(), pvTable_.begin() + static_cast<std::ptrdiff_t>(pvLength_[0])};
     }
 
 
@@ -583,10 +1034,10 @@ public:
     /**
      * @brief setup minimax, if parameter is not specified by user, default value will be used
      * @param searchDepth number of one color moves to check in minimax
-     * @param addCheckmateMoves if true, checkmate moves will be added to checkMateList_
-     * @param pruningSize number of moves to consider in minimax
+     * @param addCheckmateMoves if true, mating line will be added to checkMateList_
+     * @param pruningPolicy number of moves to consider for attacker and defender
      */
-    void setupMinimax(size_t searchDepth, bool addCheckmateMoves, size_t pruningSize);
+    void setupMinimax(size_t searchDepth, bool addCheckmateMoves, const PruningPolicy &pruningPolicy);
 
 
     /**
@@ -598,6 +1049,32 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const piece_move& move);
 
 
+    /**
+     * @brief Get move in coordinate notation (e.g. e2e4, e7e8q), move has to be legal in current position
+     * @param move move to convert
+     * @return move in coordinate notation, empty string if move is not on chessboard
+     */
+    std::string moveNotation(const piece_move &move) const;
+
+
+    /**
+     * @brief Get line of moves in coordinate notation, moves are played on the board and then taken back
+     * @param line moves of both players starting in current position
+     * @return moves in coordinate notation
+     */
+    std::vector<std::string> lineNotation(const piece_moves &line);
+
+
+    /**
+     * @brief Get position in coordinate notation (e.g. e4)
+     * @param position position to convert
+     * @return position in coordinate notation
+     */
+    static std::string positionNotation(const Position &position) {
+        return {static_cast<char>('a' + position.y_), static_cast<char>('8' - position.x_)};
+    }
+
+
     /**
      * @brief return vector piece_moves that lead to checkmate
      * @return
@@ -614,7 +1091,25 @@ public:
     const piece_move &getBestMove() const {
         return bestStartingMove_;
     }
+
+
+    /**
+     * @brief return statistics of last search
+     * @return statistics collected by last findCheckMate call
+     */
+    const SearchStats &getSearchStats() const {
+        return searchStats_;
+    }
 };
 
 
+/**
+ * @brief Overload operator<< to print piece move to output stream
+ * @param os output stream to print to
+ * @param move move to print
+ * @return output stream
+ */
+std::ostream& operator<<(std::ostream& os, const piece_move& move);
+
+
 #endif //CHESS_H
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <optional>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include "Socket.h"
+
+// test client of solver daemon, sends JSON requests from stdin (one per line) and prints responses,
+// see USAGE.md for more info
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [--socket path] < requests.ndjson" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    std::string socketPath = DEFAULT_SOCKET_PATH;
+    if (argc == 3 && std::string(argv[1]) == "--socket") {
+        socketPath = argv[2];
+    }
+    else if (argc != 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        int fd = Socket::connect(socketPath);
+
+        // responses are printed while requests are still being sent
+        std::thread reader([fd] {
+            try {
+                while (std::optional<std::string> response = Socket::readMessage(fd)) {
+                    std::cout << *response << std::endl;
+                }
+            }
+            catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+            }
+        });
+
+        try {
+            std::string line;
+            while (std::getline(std::cin, line)) {
+                if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                    Socket::writeMessage(fd, line);
+                }
+            }
+        }
+        catch (...) {
+            // joinable reader would terminate program, shutdown in both directions wakes it from blocking read
+            ::shutdown(fd, SHUT_RDWR);
+            reader.join();
+            ::close(fd);
+            throw;
+        }
+
+        // daemon closes connection after all responses are sent
+        ::shutdown(fd, SHUT_WR);
+        reader.join();
+        ::close(fd);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,299 @@
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "SolveRequest.h"
+#include "Socket.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+// solver daemon, solves JSON requests received over Unix domain socket, see USAGE.md for more info
+
+
+static volatile std::sig_atomic_t stopRequested = 0;  ///< Set by SIGINT or SIGTERM
+static const int ACCEPT_POLL_TIMEOUT = 200;           ///< Milliseconds between checks of stopRequested
+
+
+/**
+ * @brief Daemon settings given on command line
+ */
+struct DaemonSettings {
+    size_t threadCount = 0;                        ///< Number of worker threads, 0 = hardware threads
+    std::string socketPath = DEFAULT_SOCKET_PATH;  ///< Path of listening socket
+    std::string cachePath;                         ///< Solution cache file, empty = no cache
+    std::string tablebasePath;                     ///< Directory of endgame tables, empty = no tables
+    std::string tracePath;                         ///< Chrome trace file written at exit, empty = no tracing
+};
+
+
+/**
+ * @brief Connection of one client, closed when handler and all its requests are finished.
+ */
+struct Connection {
+    int fd;                  ///< File descriptor of connected socket
+    std::mutex writeMutex;   ///< Responses are written by multiple workers
+
+
+    /**
+     * @brief Constructor
+     * @param fd file descriptor of connected socket
+     */
+    explicit Connection(int fd) : fd(fd) {}
+
+
+    /**
+     * @brief Destructor, closes socket
+     */
+    ~Connection() {
+        ::close(fd);
+    }
+
+
+    /**
+     * @brief Send response, errors are ignored because client might have already disconnected
+     * @param message response to send
+     */
+    void send(const std::string &message) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        try {
+            Socket::writeMessage(fd, message);
+        }
+        catch (const std::exception &) {
+        }
+    }
+};
+
+
+/**
+ * @brief Daemon keeping worker threads and their Chess instances warm between requests and connections.
+ */
+class Daemon {
+public:
+    /**
+     * @brief Constructor, starts worker threads
+     * @param threadCount number of worker threads, 0 means number of hardware threads
+     * @param solutionCache cache shared by all workers, nullptr = no cache
+     * @param tablebases endgame tables shared by all workers, nullptr = no tables
+     */
+    Daemon(size_t threadCount, SolutionCache *solutionCache, const Tablebases *tablebases)
+            : pool_(threadCount), games_(pool_.size()) {
+        for (Chess &chess : games_) {
+            chess.setSolutionCache(solutionCache);
+            chess.setTablebases(tablebases);
+        }
+    }
+
+
+    /**
+     * @brief Accept connections until SIGINT or SIGTERM, then finish running requests
+     * @param listenFd file descriptor of listening socket
+     */
+    void run(int listenFd) {
+        pollfd listening{listenFd, POLLIN, 0};
+
+        while (!stopRequested) {
+            if (::poll(&listening, 1, ACCEPT_POLL_TIMEOUT) <= 0) {
+                continue;
+            }
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+
+            auto connection = std::make_shared<Connection>(fd);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connections_.push_back(connection);
+                ++handlers_;
+            }
+            std::thread(&Daemon::handle, this, connection).detach();
+        }
+        stop();
+    }
+
+
+private:
+    /**
+     * @brief Read requests of one connection and submit them to workers
+     * @param connection connection of client
+     */
+    void handle(std::shared_ptr<Connection> connection) {
+        try {
+            while (std::optional<std::string> message = Socket::readMessage(connection->fd)) {
+                submit(connection, *message);
+            }
+        }
+        catch (const std::exception &e) {
+            connection->send(SolveResult::failure("null", e.what()).toJson());
+        }
+
+        // reading is over -> connection is forgotten, pending responses own it until they are sent
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::erase_if(connections_, [&connection](const std::weak_ptr<Connection> &weakConnection) {
+            return weakConnection.expired() || weakConnection.lock() == connection;
+        });
+        --handlers_;
+        handlersFinished_.notify_all();
+    }
+
+
+    /**
+     * @brief Parse request and submit it to workers, response is sent as soon as request is solved
+     * @param connection connection of client
+     * @param message JSON request
+     */
+    void submit(const std::shared_ptr<Connection> &connection, const std::string &message) {
+        std::string id = "null";
+        try {
+            JsonObject object = JsonObject::parse(message);
+            id = object.getRaw("id");
+            SolveRequest request = SolveRequest::fromJson(object);
+
+            // task owns connection -> socket stays open until all responses are sent
+            pool_.submit([this, connection, request = std::move(request)](size_t worker) {
+                connection->send(request.solve(games_[worker]).toJson());
+            });
+        }
+        catch (const std::exception &e) {
+            connection->send(SolveResult::failure(id, e.what()).toJson());
+        }
+    }
+
+
+    /**
+     * @brief Stop reading from open connections and wait for handlers and submitted requests
+     */
+    void stop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const std::weak_ptr<Connection> &weakConnection : connections_) {
+            if (std::shared_ptr<Connection> connection = weakConnection.lock()) {
+                ::shutdown(connection->fd, SHUT_RD);
+            }
+        }
+        handlersFinished_.wait(lock, [this] { return handlers_ == 0; });
+        lock.unlock();
+        pool_.wait();
+    }
+
+
+    ThreadPool pool_;                                     ///< Worker threads
+    std::vector<Chess> games_;                            ///< One chess per worker, reused between requests
+    std::mutex mutex_;                                    ///< Guards connections_ and handlers_
+    std::condition_variable handlersFinished_;            ///< Signals finished connection handler
+    std::vector<std::weak_ptr<Connection>> connections_;  ///< Connections with running handler
+    size_t handlers_ = 0;                                 ///< Number of running connection handlers
+};
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-j threads] [--socket path] [--cache file] [--tablebases directory]"
+              << " [--trace file]" << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return settings, empty if arguments are invalid
+ */
+static std::optional<DaemonSettings> parseArguments(int argc, char *argv[]) {
+    DaemonSettings settings;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "-j" && hasValue) {
+                settings.threadCount = std::stoul(argv[++i]);
+            }
+            else if (argument == "--socket" && hasValue) {
+                settings.socketPath = argv[++i];
+            }
+            else if (argument == "--cache" && hasValue) {
+                settings.cachePath = argv[++i];
+            }
+            else if (argument == "--tablebases" && hasValue) {
+                settings.tablebasePath = argv[++i];
+            }
+            else if (argument == "--trace" && hasValue) {
+                settings.tracePath = argv[++i];
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    return settings;
+}
+
+
+/**
+ * @brief Signal handler requesting stop of daemon
+ */
+static void requestStop(int) {
+    stopRequested = 1;
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<DaemonSettings> settings = parseArguments(argc, argv);
+    if (!settings) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    try {
+        std::unique_ptr<SolutionCache> cache;
+        if (!settings->cachePath.empty()) {
+            cache = std::make_unique<SolutionCache>(settings->cachePath);
+        }
+        std::unique_ptr<Tablebases> tablebases;
+        if (!settings->tablebasePath.empty()) {
+            tablebases = std::make_unique<Tablebases>(settings->tablebasePath);
+        }
+        std::ofstream traceFile;
+        if (!settings->tracePath.empty()) {
+            traceFile.open(settings->tracePath);
+            if (!traceFile) {
+                throw std::runtime_error("Failed to open file " + settings->tracePath);
+            }
+            Trace::enable();
+        }
+        int listenFd = Socket::listen(settings->socketPath);
+        Daemon daemon(settings->threadCount, cache.get(), tablebases.get());
+        std::cerr << "Listening on " << settings->socketPath << std::endl;
+
+        daemon.run(listenFd);
+        ::close(listenFd);
+        ::unlink(settings->socketPath.c_str());
+
+        // running requests are finished -> workers are idle, ring buffers hold the latest searches
+        if (Trace::isEnabled()) {
+            Trace::disable();
+            Trace::writeChromeTrace(traceFile);
+            Trace::printProfile(std::cerr);
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -206,6 +206,153 @@ public:
     InvalidSearchDepth() : message("Error: Search depth cannot be 0") {}
 
 
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+
+/**
+ * @brief Exception class for invalid puzzle file.
+ */
+class InvalidPuzzleFormat : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidPuzzleFormat.
+     * @param fileName name of the puzzle file
+     */
+    explicit InvalidPuzzleFormat(const std::string &fileName) : message("Error: Invalid puzzle format in " + fileName) {}
+
+
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+
+/**
+ * @brief Exception class for invalid JSON text.
+ */
+class InvalidJsonFormat : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidJsonFormat.
+     */
+    InvalidJsonFormat() : message("Error: Invalid JSON format") {}
+
+
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+
+/**
+ * @brief Exception class for illegal or malformed moves.
+ */
+class InvalidMove : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidMove.
+     * @param move The move that is not legal.
+     */
+    explicit InvalidMove(const std::string &move) : message("Error: Invalid move " + move) {}
+
+
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+/**
+ * @brief Exception class for file which is not solution cache.
+ */
+class InvalidCacheFile : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidCacheFile.
+     * @param path The path of the invalid file.
+     */
+    explicit InvalidCacheFile(const std::string &path) : message("Error: Invalid solution cache file " + path) {}
+
+
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+/**
+ * @brief Exception class for unsupported endgame material.
+ */
+class InvalidMaterial : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidMaterial.
+     * @param material The name of the material.
+     */
+    explicit InvalidMaterial(const std::string &material) : message("Error: Invalid endgame material " + material) {}
+
+
+    /**
+     * @brief Returns the error message associated with the exception.
+     * @return A const char pointer to the error message.
+     */
+    const char* what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
+
+/**
+ * @brief Exception class for file which is not endgame table.
+ */
+class InvalidTablebaseFile : public std::exception {
+public:
+    /**
+     * @brief Constructor for InvalidTablebaseFile.
+     * @param path The path of the invalid file.
+     */
+    explicit InvalidTablebaseFile(const std::string &path) : message("Error: Invalid tablebase file " + path) {}
+
+
     /**
      * @brief Returns the error message associated with the exception.
      * @return A const char pointer to the error message.
@@ -0,0 +1,302 @@
+#include "Json.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+
+
+/**
+ * @brief Skip whitespace characters
+ * @param text text to parse
+ * @param position position to move
+ */
+static void skipWhitespace(const std::string &text, size_t &position) {
+    while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+        ++position;
+    }
+}
+
+
+/**
+ * @brief Check that character at position is expected and move after it
+ * @param text text to parse
+ * @param position position to check
+ * @param expected expected character
+ */
+static void expect(const std::string &text, size_t &position, char expected) {
+    skipWhitespace(text, position);
+    if (position >= text.size() || text[position] != expected) {
+        throw InvalidJsonFormat();
+    }
+    ++position;
+}
+
+
+/**
+ * @brief Check if raw value is JSON number, true, false or null
+ * @param value raw value
+ * @return true if value is valid JSON literal
+ */
+static bool isRawValue(const std::string &value) {
+    if (value == "true" || value == "false" || value == "null") {
+        return true;
+    }
+
+    // number = [-] (0 | [1-9] digits) [. digits] [(e | E) [+ | -] digits]
+    size_t position = 0;
+    auto digits = [&value, &position]() {
+        size_t start = position;
+        while (position < value.size() && std::isdigit(static_cast<unsigned char>(value[position]))) {
+            ++position;
+        }
+        return position > start;
+    };
+
+    if (position < value.size() && value[position] == '-') {
+        ++position;
+    }
+    if (position < value.size() && value[position] == '0') {
+        ++position;
+    }
+    else if (!digits()) {
+        return false;
+    }
+    if (position < value.size() && value[position] == '.') {
+        ++position;
+        if (!digits()) {
+            return false;
+        }
+    }
+    if (position < value.size() && (value[position] == 'e' || value[position] == 'E')) {
+        ++position;
+        if (position < value.size() && (value[position] == '+' || value[position] == '-')) {
+            ++position;
+        }
+        if (!digits()) {
+            return false;
+        }
+    }
+    return position == value.size();
+}
+
+
+/**
+ * @brief Parse JSON object
+ * @param text text with one JSON object
+ * @return parsed object
+ */
+JsonObject JsonObject::parse(const std::string &text) {
+    JsonObject object;
+    size_t position = 0;
+
+    object.parseObject(text, position, "");
+    skipWhitespace(text, position);
+    if (position != text.size()) {
+        throw InvalidJsonFormat();
+    }
+    return object;
+}
+
+
+/**
+ * @brief Parse object starting at position, values are stored with prefix
+ * @param text text to parse
+ * @param position position of '{', will be set after '}'
+ * @param prefix prefix of keys
+ */
+void JsonObject::parseObject(const std::string &text, size_t &position, const std::string &prefix) {
+    expect(text, position, '{');
+    skipWhitespace(text, position);
+    if (position < text.size() && text[position] == '}') {
+        ++position;
+        return;
+    }
+
+    while (true) {
+        skipWhitespace(text, position);
+        std::string key = prefix + parseString(text, position);
+        expect(text, position, ':');
+        skipWhitespace(text, position);
+
+        if (position >= text.size()) {
+            throw InvalidJsonFormat();
+        }
+        else if (text[position] == '{') {
+            parseObject(text, position, key + ".");
+        }
+        else if (text[position] == '"') {
+            values_[key] = parseString(text, position);
+            isString_[key] = true;
+        }
+        else {
+            // number, true, false or null -> stored as raw text
+            size_t end = position;
+            while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) ||
+                                         text[end] == '-' || text[end] == '+' || text[end] == '.')) {
+                ++end;
+            }
+            std::string value = text.substr(position, end - position);
+            if (!isRawValue(value)) {
+                throw InvalidJsonFormat();
+            }
+            values_[key] = value;
+            isString_[key] = false;
+            position = end;
+        }
+
+        skipWhitespace(text, position);
+        if (position < text.size() && text[position] == ',') {
+            ++position;
+            continue;
+        }
+        expect(text, position, '}');
+        return;
+    }
+}
+
+
+/**
+ * @brief Parse string starting at position
+ * @param text text to parse
+ * @param position position of opening quote, will be set after closing quote
+ * @return unescaped string
+ */
+std::string JsonObject::parseString(const std::string &text, size_t &position) {
+    expect(text, position, '"');
+    std::string value;
+
+    while (position < text.size() && text[position] != '"') {
+        char character = text[position++];
+        if (character != '\\') {
+            value += character;
+            continue;
+        }
+        if (position >= text.size()) {
+            throw InvalidJsonFormat();
+        }
+
+        switch (char escaped = text[position++]) {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'u': {
+                // only basic multilingual plane, encoded to UTF-8
+                if (position + 4 > text.size()) {
+                    throw InvalidJsonFormat();
+                }
+                unsigned int code = std::stoul(text.substr(position, 4), nullptr, 16);
+                position += 4;
+                if (code < 0x80) {
+                    value += static_cast<char>(code);
+                }
+                else if (code < 0x800) {
+                    value += static_cast<char>(0xC0 | (code >> 6));
+                    value += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                else {
+                    value += static_cast<char>(0xE0 | (code >> 12));
+                    value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    value += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                value += escaped;
+        }
+    }
+    expect(text, position, '"');
+    return value;
+}
+
+
+/**
+ * @brief Get string value
+ * @param key key of value
+ * @param defaultValue value returned if key is missing
+ * @return string value
+ */
+std::string JsonObject::getString(const std::string &key, const std::string &defaultValue) const {
+    return has(key) ? values_.at(key) : defaultValue;
+}
+
+
+/**
+ * @brief Get non-negative integer value
+ * @param key key of value
+ * @param defaultValue value returned if key is missing
+ * @return integer value
+ */
+size_t JsonObject::getSize(const std::string &key, size_t defaultValue) const {
+    if (!has(key)) {
+        return defaultValue;
+    }
+    const std::string &value = values_.at(key);
+    if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+        throw InvalidJsonFormat();
+    }
+    return std::stoul(value);
+}
+
+
+/**
+ * @brief Get boolean value
+ * @param key key of value
+ * @param defaultValue value returned if key is missing
+ * @return boolean value
+ */
+bool JsonObject::getBool(const std::string &key, bool defaultValue) const {
+    if (!has(key)) {
+        return defaultValue;
+    }
+    const std::string &value = values_.at(key);
+    if (isString_.at(key) || (value != "true" && value != "false")) {
+        throw InvalidJsonFormat();
+    }
+    return value == "true";
+}
+
+
+/**
+ * @brief Get value as JSON text -> strings are quoted and escaped, so value can be copied to another object
+ * @param key key of value
+ * @return JSON text of value, null if key is missing
+ */
+std::string JsonObject::getRaw(const std::string &key) const {
+    if (!has(key)) {
+        return "null";
+    }
+    return isString_.at(key) ? quote(values_.at(key)) : values_.at(key);
+}
+
+
+/**
+ * @brief Escape string and put it to quotes
+ * @param text text to escape
+ * @return JSON string
+ */
+std::string JsonObject::quote(const std::string &text) {
+    std::ostringstream os;
+    os << '"';
+    for (char character : text) {
+        switch (character) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            case '\r': os << "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character);
+                    os << std::dec;
+                }
+                else {
+                    os << character;
+                }
+        }
+    }
+    os << '"';
+    return os.str();
+}
@@ -0,0 +1,181 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+
+/**
+ * @brief Flat JSON object with scalar values, used for one-line requests and results.
+ * @details Nested objects are flattened, key "b" in object "a" is stored as "a.b". Arrays are not supported.
+ */
+class JsonObject {
+private:
+    std::map<std::string, std::string> values_;  ///< Scalar values, strings are unescaped, other values are raw text
+    std::map<std::string, bool> isString_;       ///< True if value was JSON string
+
+public:
+    /**
+     * @brief Parse JSON object
+     * @param text text with one JSON object
+     * @return parsed object
+     */
+    static JsonObject parse(const std::string &text);
+
+
+    /**
+     * @brief Check if object contains key
+     * @param key key to find
+     * @return true if object contains key with non-null value
+     */
+    bool has(const std::string &key) const {
+        auto it = values_.find(key);
+        return it != values_.end() && (isString_.at(key) || it->second != "null");
+    }
+
+
+    /**
+     * @brief Get string value
+     * @param key key of value
+     * @param defaultValue value returned if key is missing
+     * @return string value
+     */
+    std::string getString(const std::string &key, const std::string &defaultValue = "") const;
+
+
+    /**
+     * @brief Get non-negative integer value
+     * @param key key of value
+     * @param defaultValue value returned if key is missing
+     * @return integer value
+     */
+    size_t getSize(const std::string &key, size_t defaultValue) const;
+
+
+    /**
+     * @brief Get boolean value
+     * @param key key of value
+     * @param defaultValue value returned if key is missing
+     * @return boolean value
+     */
+    bool getBool(const std::string &key, bool defaultValue) const;
+
+
+    /**
+     * @brief Get value as JSON text -> strings are quoted and escaped, so value can be copied to another object
+     * @param key key of value
+     * @return JSON text of value, null if key is missing
+     */
+    std::string getRaw(const std::string &key) const;
+
+
+    /**
+     * @brief Escape string and put it to quotes
+     * @param text text to escape
+     * @return JSON string
+     */
+    static std::string quote(const std::string &text);
+
+
+private:
+    /**
+     * @brief Parse object starting at position, values are stored with prefix
+     * @param text text to parse
+     * @param position position of '{', will be set after '}'
+     * @param prefix prefix of keys
+     */
+    void parseObject(const std::string &text, size_t &position, const std::string &prefix);
+
+
+    /**
+     * @brief Parse string starting at position
+     * @param text text to parse
+     * @param position position of opening quote, will be set after closing quote
+     * @return unescaped string
+     */
+    static std::string parseString(const std::string &text, size_t &position);
+};
+
+
+/**
+ * @brief Builder of one-line JSON object.
+ */
+class JsonWriter {
+private:
+    std::ostringstream os_;  ///< Written members
+    bool empty_ = true;      ///< No member was written yet
+
+public:
+    /**
+     * @brief Add string member
+     * @param key key of member
+     * @param value value of member
+     * @return this writer
+     */
+    JsonWriter &add(const std::string &key, const std::string &value) {
+        return addRaw(key, JsonObject::quote(value));
+    }
+
+
+    /**
+     * @brief Add string member
+     * @param key key of member
+     * @param value value of member
+     * @return this writer
+     */
+    JsonWriter &add(const std::string &key, const char *value) {
+        return add(key, std::string(value));
+    }
+
+
+    /**
+     * @brief Add boolean member
+     * @param key key of member
+     * @param value value of member
+     * @return this writer
+     */
+    JsonWriter &add(const std::string &key, bool value) {
+        return addRaw(key, value ? "true" : "false");
+    }
+
+
+    /**
+     * @brief Add number member
+     * @param key key of member
+     * @param value value of member
+     * @return this writer
+     */
+    template<typename T>
+    JsonWriter &add(const std::string &key, T value) requires std::is_arithmetic_v<T> {
+        std::ostringstream number;
+        number << value;
+        return addRaw(key, number.str());
+    }
+
+
+    /**
+     * @brief Add member with value which is already JSON text
+     * @param key key of member
+     * @param json JSON text of value
+     * @return this writer
+     */
+    JsonWriter &addRaw(const std::string &key, const std::string &json) {
+        os_ << (empty_ ? "{" : ",") << JsonObject::quote(key) << ":" << json;
+        empty_ = false;
+        return *this;
+    }
+
+
+    /**
+     * @brief Get written object
+     * @return JSON text of object
+     */
+    std::string str() const {
+        return empty_ ? "{}" : os_.str() + "}";
+    }
+};
+
+
+#endif //JSON_H
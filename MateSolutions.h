@@ -0,0 +1,44 @@
+#ifndef MATESOLUTIONS_H
+#define MATESOLUTIONS_H
+
+#include <cstdint>
+#include "Types.h"
+#include "SearchLimits.h"
+
+
+/**
+ * @brief Struct with all solutions of mate in N puzzle found by Chess::findAllCheckMates.
+ * @details Mating line is sequence of moves where attacker plays any move which still forces checkmate and defender
+ * plays any legal move. Number of lines can be huge, it saturates at SIZE_MAX.
+ */
+struct MateSolutions {
+    piece_moves firstMoves;                         ///< All attacker first moves forcing checkmate
+    std::vector<size_t> lineCounts;                 ///< Number of mating lines for each first move, empty if not counted
+    size_t lineCount = 0;                           ///< Number of all mating lines, 0 if not counted
+    size_t positions = 0;                           ///< Number of distinct solved positions
+    size_t transpositions = 0;                      ///< Number of positions reused from memo instead of solving again
+    SearchStatus status = SearchStatus::COMPLETED;  ///< How the search ended, solutions are incomplete if interrupted
+
+
+    /**
+     * @brief Check if puzzle has unique solution
+     * @return true if exactly one first move forces checkmate
+     */
+    bool isUnique() const {
+        return firstMoves.size() == 1;
+    }
+};
+
+
+/**
+ * @brief Add numbers of lines, result saturates at SIZE_MAX
+ * @param a first number
+ * @param b second number
+ * @return a + b or SIZE_MAX if it overflows
+ */
+inline size_t saturatingAdd(size_t a, size_t b) {
+    return (a > SIZE_MAX - b) ? SIZE_MAX : a + b;
+}
+
+
+#endif //MATESOLUTIONS_H
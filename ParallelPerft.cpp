@@ -0,0 +1,61 @@
+#include "ParallelPerft.h"
+
+
+/**
+ * @brief Constructor, starts worker threads
+ * @param threadCount number of worker threads, 0 means number of hardware threads
+ * @param hashSizeMiB size of shared perft table in MiB, 0 disables hashing
+ */
+ParallelPerft::ParallelPerft(size_t threadCount, size_t hashSizeMiB) : pool_(threadCount), games_(pool_.size()) {
+    table_ = hashSizeMiB > 0 ? std::make_unique<PerftTable>(hashSizeMiB) : nullptr;
+    for (Chess &chess : games_) {
+        chess.setPerftTable(table_.get());
+    }
+}
+
+
+/**
+ * @brief Count leaf nodes of legal move tree separately for each root move
+ * @param chess chess with the root position
+ * @param colorOnMove color of player on move
+ * @param depth number of half-moves including root move, at least 1
+ * @return root moves in generation order with number of positions reached after each of them
+ */
+std::vector<std::pair<piece_move, size_t>> ParallelPerft::divide(Chess &chess, Color colorOnMove, size_t depth) {
+    std::string FENCode = chess.getFENCode();
+    move_list moves = chess.getAllMoves(colorOnMove);
+    std::vector<std::pair<piece_move, size_t>> counts(moves.size());
+
+    // tasks write to different elements, wait publishes them
+    for (size_t i = 0; i < moves.size(); ++i) {
+        pool_.submit([&, i](size_t worker) {
+            Chess &game = games_[worker];
+            game.clearGame();
+            game.loadFENGame(FENCode);
+            game.makeMove(moves[i]);
+            counts[i] = {moves[i], game.perft(game.getOppositeColor(colorOnMove), depth - 1)};
+        });
+    }
+    pool_.wait();
+    return counts;
+}
+
+
+/**
+ * @brief Count leaf nodes of legal move tree
+ * @param chess chess with the root position
+ * @param colorOnMove color of player on move
+ * @param depth number of half-moves
+ * @return number of positions reached after depth half-moves
+ */
+size_t ParallelPerft::perft(Chess &chess, Color colorOnMove, size_t depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    size_t nodes = 0;
+    for (const auto &[move, count] : divide(chess, colorOnMove, depth)) {
+        nodes += count;
+    }
+    return nodes;
+}
@@ -0,0 +1,64 @@
+#ifndef PARALLELPERFT_H
+#define PARALLELPERFT_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Chess.h"
+#include "PerftTable.h"
+#include "ThreadPool.h"
+
+
+/**
+ * @brief Perft split at the root between worker threads, see USAGE.md for more info.
+ * @details Each root move is one task, worker loads the position from FEN to its own Chess, does the move and counts
+ * the subtree. Workers optionally share one perft table, so subtrees transposed between root moves are counted once.
+ */
+class ParallelPerft {
+public:
+    /**
+     * @brief Constructor, starts worker threads
+     * @param threadCount number of worker threads, 0 means number of hardware threads
+     * @param hashSizeMiB size of shared perft table in MiB, 0 disables hashing
+     */
+    explicit ParallelPerft(size_t threadCount = 0, size_t hashSizeMiB = 0);
+
+
+    /**
+     * @brief Count leaf nodes of legal move tree separately for each root move
+     * @param chess chess with the root position
+     * @param colorOnMove color of player on move
+     * @param depth number of half-moves including root move, at least 1
+     * @return root moves in generation order with number of positions reached after each of them
+     */
+    std::vector<std::pair<piece_move, size_t>> divide(Chess &chess, Color colorOnMove, size_t depth);
+
+
+    /**
+     * @brief Count leaf nodes of legal move tree
+     * @param chess chess with the root position
+     * @param colorOnMove color of player on move
+     * @param depth number of half-moves
+     * @return number of positions reached after depth half-moves
+     */
+    size_t perft(Chess &chess, Color colorOnMove, size_t depth);
+
+
+    /**
+     * @brief Get number of worker threads
+     * @return number of worker threads
+     */
+    size_t size() const {
+        return pool_.size();
+    }
+
+
+private:
+    ThreadPool pool_;                    ///< Workers counting subtrees of root moves
+    std::vector<Chess> games_;           ///< Chess of each worker
+    std::unique_ptr<PerftTable> table_;  ///< Table shared by workers, nullptr = no hashing
+};
+
+
+#endif //PARALLELPERFT_H
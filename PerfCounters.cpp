@@ -0,0 +1,128 @@
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef __linux__
+/**
+ * @brief Open counter of hardware event for calling thread on any CPU, counter is disabled
+ * @param config PERF_COUNT_HW_* event
+ * @return file descriptor, -1 on error with errno set
+ */
+static int openCounter(std::uint64_t config) {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+#endif
+
+
+/**
+ * @brief Constructor, opens counters of calling thread, they are stopped
+ */
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+#ifdef __linux__
+    static const std::uint64_t configs[PERF_EVENT_COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (size_t event = 0; event < PERF_EVENT_COUNT; ++event) {
+        fds_[event] = openCounter(configs[event]);
+        if (fds_[event] < 0 && error_.empty()) {
+            error_ = std::string("perf_event_open failed for ") + eventName(static_cast<PerfEvent>(event)) + ": " +
+                     std::strerror(errno);
+        }
+    }
+#else
+    error_ = "perf_event_open is available only on Linux";
+#endif
+}
+
+
+/**
+ * @brief Destructor, closes counters
+ */
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+
+/**
+ * @brief Check if at least one counter is open
+ * @return true if some event is counted
+ */
+bool PerfCounters::available() const {
+    return std::any_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+}
+
+
+/**
+ * @brief Reset counters and start counting
+ */
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+
+/**
+ * @brief Stop counting and read counters
+ * @return counts since start
+ */
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (size_t event = 0; event < PERF_EVENT_COUNT; ++event) {
+        // value, time enabled and time running -> counter multiplexed with others ran only part of time
+        std::uint64_t values[3];
+        if (fds_[event] < 0 || ::read(fds_[event], values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+            continue;
+        }
+        double scale = static_cast<double>(values[1]) / values[2];
+        sample.counts[event] = static_cast<std::uint64_t>(values[0] * scale);
+    }
+#endif
+    return sample;
+}
+
+
+/**
+ * @brief Get name of event used in reports
+ * @param event counted event
+ * @return name of event in camel case
+ */
+const char *PerfCounters::eventName(PerfEvent event) {
+    static const char *names[PERF_EVENT_COUNT] = {"cycles", "instructions", "cacheMisses", "branchMisses"};
+    return names[static_cast<size_t>(event)];
+}
@@ -0,0 +1,123 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+
+/**
+ * @brief Hardware events counted by PerfCounters
+ */
+enum class PerfEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES
+};
+
+static const size_t PERF_EVENT_COUNT = 4;  ///< Number of PerfEvent values
+
+
+/**
+ * @brief Counts of hardware events of one measurement, event is empty if its counter is not available
+ */
+struct PerfSample {
+    std::array<std::optional<std::uint64_t>, PERF_EVENT_COUNT> counts;  ///< Count of each PerfEvent
+
+
+    /**
+     * @brief Get count of event divided by number of nodes
+     * @param event counted event
+     * @param nodes number of searched nodes
+     * @return count per node, empty if event was not counted or there are no nodes
+     */
+    std::optional<double> perNode(PerfEvent event, size_t nodes) const {
+        const std::optional<std::uint64_t> &count = counts[static_cast<size_t>(event)];
+        return count && nodes > 0 ? std::optional<double>(static_cast<double>(*count) / nodes) : std::nullopt;
+    }
+
+
+    /**
+     * @brief Get instructions per cycle
+     * @return instructions per cycle, empty if cycles or instructions were not counted
+     */
+    std::optional<double> instructionsPerCycle() const {
+        const std::optional<std::uint64_t> &cycles = counts[static_cast<size_t>(PerfEvent::CYCLES)];
+        const std::optional<std::uint64_t> &instructions = counts[static_cast<size_t>(PerfEvent::INSTRUCTIONS)];
+        return cycles && instructions && *cycles > 0 ?
+               std::optional<double>(static_cast<double>(*instructions) / *cycles) : std::nullopt;
+    }
+};
+
+
+/**
+ * @brief Hardware performance counters of calling thread read by Linux perf_event_open, user space only.
+ * @details Counters which cannot be opened (no PMU in virtual machine or container, perf_event_paranoid, other
+ * systems than Linux) are left out, so measurement works with any subset of events, including none. Counts are scaled
+ * when kernel multiplexes counters.
+ */
+class PerfCounters {
+public:
+    /**
+     * @brief Constructor, opens counters of calling thread, they are stopped
+     */
+    PerfCounters();
+
+
+    /**
+     * @brief Destructor, closes counters
+     */
+    ~PerfCounters();
+
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+
+    /**
+     * @brief Check if at least one counter is open
+     * @return true if some event is counted
+     */
+    bool available() const;
+
+
+    /**
+     * @brief Get reason why counters are not available
+     * @return error of opening the first counter, empty if all counters are open
+     */
+    const std::string &error() const {
+        return error_;
+    }
+
+
+    /**
+     * @brief Reset counters and start counting
+     */
+    void start();
+
+
+    /**
+     * @brief Stop counting and read counters
+     * @return counts since start
+     */
+    PerfSample stop();
+
+
+    /**
+     * @brief Get name of event used in reports
+     * @param event counted event
+     * @return name of event in camel case
+     */
+    static const char *eventName(PerfEvent event);
+
+
+private:
+    std::array<int, PERF_EVENT_COUNT> fds_;  ///< File descriptor of each counter, -1 = not available
+    std::string error_;                      ///< Error of the first counter which could not be opened
+};
+
+
+#endif //PERFCOUNTERS_H
@@ -0,0 +1,179 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include "ParallelPerft.h"
+
+// perft validation and benchmark of move generation, see USAGE.md for more info
+
+
+/**
+ * @brief Perft settings given on command line
+ */
+struct PerftSettings {
+    size_t threadCount = 0;             ///< Number of worker threads, 0 = hardware threads
+    size_t hashSize = 0;                ///< Size of perft table in MiB, 0 = no hashing
+    size_t maxDepth = SIZE_MAX;         ///< Deeper counts of suite positions are skipped
+    size_t divideDepth = 0;             ///< Depth of divide, 0 = run suites
+    std::string FENCode;                ///< Position of divide
+    std::string colorOnMove = "white";  ///< Color on move in position of divide
+    std::vector<std::string> suites;    ///< Suite files
+};
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-j threads] [--hash MiB] [--max-depth N] <suite file>..." << std::endl;
+    std::cerr << "       " << program << " [-j threads] [--hash MiB] --divide N <FEN> [white|black]" << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return settings, empty if arguments are invalid
+ */
+static std::optional<PerftSettings> parseArguments(int argc, char *argv[]) {
+    PerftSettings settings;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "-j" && hasValue) {
+                settings.threadCount = std::stoul(argv[++i]);
+            }
+            else if (argument == "--hash" && hasValue) {
+                settings.hashSize = std::stoul(argv[++i]);
+            }
+            else if (argument == "--max-depth" && hasValue) {
+                settings.maxDepth = std::stoul(argv[++i]);
+            }
+            else if (argument == "--divide" && i + 2 < argc) {
+                settings.divideDepth = std::stoul(argv[++i]);
+                settings.FENCode = argv[++i];
+                settings.colorOnMove = (i + 1 < argc) ? argv[++i] : settings.colorOnMove;
+            }
+            else if (!argument.empty() && argument[0] == '-') {
+                return std::nullopt;
+            }
+            else {
+                settings.suites.push_back(argument);
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    if (settings.divideDepth == 0 && settings.suites.empty()) {
+        return std::nullopt;
+    }
+    return settings;
+}
+
+
+/**
+ * @brief Print number of leaf nodes after each root move and their sum
+ * @param perft workers counting root moves
+ * @param settings perft settings with position and depth of divide
+ */
+static void divide(ParallelPerft &perft, const PerftSettings &settings) {
+    Chess chess;
+    chess.loadFENGame(settings.FENCode);
+
+    size_t total = 0;
+    Color colorOnMove = Chess::loadColor(settings.colorOnMove);
+    for (const auto &[move, nodes] : perft.divide(chess, colorOnMove, settings.divideDepth)) {
+        std::cout << chess.moveNotation(move) << '\t' << nodes << '\n';
+        total += nodes;
+    }
+    std::cout << "total\t" << total << std::endl;
+}
+
+
+/**
+ * @brief Run perft of all positions of suite file and compare leaf counts with expected ones
+ * @param perft workers counting root moves
+ * @param fileName name of suite file
+ * @param settings perft settings
+ * @param nodes total number of counted leaf nodes, updated
+ * @param time total time in milliseconds, updated
+ * @return number of counts which differ from expected ones
+ */
+static size_t runSuite(ParallelPerft &perft, const std::string &fileName, const PerftSettings &settings,
+                       size_t &nodes, double &time) {
+    std::ifstream ifs(fileName);
+    if (!ifs) {
+        throw std::runtime_error("Failed to open file " + fileName);
+    }
+
+    size_t failures = 0;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::string FENCode;
+        std::string color;
+        iss >> FENCode >> color;
+
+        Chess chess;
+        chess.loadFENGame(FENCode);
+        Color colorOnMove = Chess::loadColor(color);
+
+        size_t expected;
+        for (size_t depth = 1; depth <= settings.maxDepth && iss >> expected; ++depth) {
+            auto start = std::chrono::steady_clock::now();
+            size_t count = perft.perft(chess, colorOnMove, depth);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            nodes += count;
+            time += elapsed.count();
+            failures += (count == expected) ? 0 : 1;
+            std::cout << FENCode << '\t' << color << '\t' << depth << '\t' << count << '\t' << expected << '\t'
+                      << std::fixed << std::setprecision(3) << elapsed.count() << '\t' << std::setprecision(0)
+                      << count / (elapsed.count() / 1000) << '\t' << (count == expected ? "ok" : "FAIL") << std::endl;
+        }
+    }
+    return failures;
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<PerftSettings> settings = parseArguments(argc, argv);
+    if (!settings) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        ParallelPerft perft(settings->threadCount, settings->hashSize);
+        if (settings->divideDepth > 0) {
+            divide(perft, *settings);
+            return 0;
+        }
+
+        size_t failures = 0;
+        size_t nodes = 0;
+        double time = 0;
+        for (const std::string &suite : settings->suites) {
+            failures += runSuite(perft, suite, *settings, nodes, time);
+        }
+        std::cout << "total\t" << nodes << " nodes\t" << std::fixed << std::setprecision(3) << time << " ms\t"
+                  << std::setprecision(0) << nodes / (time / 1000) << " nodes/s\t" << failures << " failed"
+                  << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef PERFTTABLE_H
+#define PERFTTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+static const size_t PERFT_DEPTH_BITS = 8;  ///< Low bits of stored data with depth, count is in the remaining bits
+
+
+/**
+ * @brief Hash table of perft counts shared by all threads without locking.
+ * @details Entry is keyed by position hash and depth. Each entry stores key xor data and data, so torn entry written
+ * by two threads at once never matches a lookup. New count always replaces the old one.
+ */
+class PerftTable {
+public:
+    /**
+     * @brief Constructor, allocates table
+     * @param sizeMiB size of table in MiB, rounded down to power of two entries
+     */
+    explicit PerftTable(size_t sizeMiB) {
+        size_t entries = 1;
+        while (2 * entries * sizeof(Entry) <= sizeMiB * 1024 * 1024) {
+            entries *= 2;
+        }
+        entries_ = std::make_unique<Entry[]>(entries);
+        mask_ = entries - 1;
+    }
+
+
+    /**
+     * @brief Find count of position
+     * @param hash hash of position including color on move
+     * @param depth number of half-moves
+     * @return number of leaf nodes, empty if position is not in table
+     */
+    std::optional<size_t> find(std::uint64_t hash, size_t depth) const {
+        const Entry &entry = entries_[hash & mask_];
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        std::uint64_t key = entry.key.load(std::memory_order_relaxed);
+        if ((key ^ data) != hash || (data & ((1ULL << PERFT_DEPTH_BITS) - 1)) != depth) {
+            return std::nullopt;
+        }
+        return data >> PERFT_DEPTH_BITS;
+    }
+
+
+    /**
+     * @brief Store count of position
+     * @param hash hash of position including color on move
+     * @param depth number of half-moves
+     * @param count number of leaf nodes
+     */
+    void store(std::uint64_t hash, size_t depth, size_t count) {
+        Entry &entry = entries_[hash & mask_];
+        std::uint64_t data = (static_cast<std::uint64_t>(count) << PERFT_DEPTH_BITS) | depth;
+        entry.key.store(hash ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+
+
+private:
+    /**
+     * @brief Entry of table
+     */
+    struct Entry {
+        std::atomic<std::uint64_t> key{0};   ///< Hash of position xor data
+        std::atomic<std::uint64_t> data{0};  ///< Count shifted by PERFT_DEPTH_BITS and depth
+    };
+
+    std::unique_ptr<Entry[]> entries_;  ///< Entries, number of entries is power of two
+    std::uint64_t mask_;                ///< Number of entries - 1
+};
+
+
+#endif //PERFTTABLE_H
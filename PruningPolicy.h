@@ -0,0 +1,128 @@
+#ifndef PRUNINGPOLICY_H
+#define PRUNINGPOLICY_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+static const size_t PRUNING_SIZE = INT_MAX;     ///< Number of best moves to consider in minimax
+
+
+/**
+ * @brief Struct describing how many best moves are searched in each minimax node.
+ * @details Width is chosen by role of player on move (attacker tries to give checkmate, defender tries to avoid it)
+ * and optionally by move number of that player. Pruning attacker moves is safe for found checkmates, because attacker
+ * needs only one good move. Pruning defender moves can fabricate checkmate.
+ */
+struct PruningPolicy {
+    size_t attackerWidth = PRUNING_SIZE;     ///< Number of attacker moves to consider
+    size_t defenderWidth = PRUNING_SIZE;     ///< Number of defender moves to consider
+    std::vector<size_t> attackerMoveWidths;  ///< Width for attacker move number i, overrides attackerWidth
+    std::vector<size_t> defenderMoveWidths;  ///< Width for defender move number i, overrides defenderWidth
+    bool verify = false;                     ///< Verify pruned results by re-search
+
+
+    /**
+     * @brief Create policy which prunes moves of both players equally
+     * @param width number of moves to consider
+     * @param verify if true, pruned results are verified by re-search
+     * @return pruning policy
+     */
+    static PruningPolicy symmetric(size_t width, bool verify = false) {
+        return {width, width, {}, {}, verify};
+    }
+
+
+    /**
+     * @brief Create policy which prunes only attacker moves, all defender replies are searched
+     * @param width number of attacker moves to consider
+     * @return pruning policy
+     */
+    static PruningPolicy attackerOnly(size_t width) {
+        return {width, PRUNING_SIZE, {}, {}, false};
+    }
+
+
+    /**
+     * @brief Get number of moves to consider
+     * @param attacker true if player on move is attacker
+     * @param ply number of half-moves from the root of minimax
+     * @return number of moves to consider
+     */
+    size_t width(bool attacker, size_t ply) const {
+        const std::vector<size_t> &moveWidths = attacker ? attackerMoveWidths : defenderMoveWidths;
+        size_t moveNumber = ply / 2;
+
+        if (moveNumber < moveWidths.size()) {
+            return moveWidths[moveNumber];
+        }
+        return attacker ? attackerWidth : defenderWidth;
+    }
+
+
+    /**
+     * @brief Check if policy can cut off some defender moves
+     * @return true if some defender moves might not be searched
+     */
+    bool prunesDefender() const {
+        return isPruned(defenderWidth, defenderMoveWidths);
+    }
+
+
+    /**
+     * @brief Check if policy can cut off some moves
+     * @return true if some moves might not be searched
+     */
+    bool prunes() const {
+        return isPruned(attackerWidth, attackerMoveWidths) || prunesDefender();
+    }
+
+
+    /**
+     * @brief Double all widths, used when pruned search did not find checkmate
+     */
+    void widen() {
+        attackerWidth = widen(attackerWidth);
+        defenderWidth = widen(defenderWidth);
+        for (size_t &width : attackerMoveWidths) {
+            width = widen(width);
+        }
+        for (size_t &width : defenderMoveWidths) {
+            width = widen(width);
+        }
+    }
+
+
+private:
+    /**
+     * @brief Double width, but never exceed PRUNING_SIZE
+     * @param width width to double
+     * @return doubled width
+     */
+    static size_t widen(size_t width) {
+        return (width > PRUNING_SIZE / 2) ? PRUNING_SIZE : std::max<size_t>(1, 2 * width);
+    }
+
+
+    /**
+     * @brief Check if default width or one of move widths prunes moves
+     * @param width default width
+     * @param moveWidths widths for move numbers
+     * @return true if some width is smaller than PRUNING_SIZE
+     */
+    static bool isPruned(size_t width, const std::vector<size_t> &moveWidths) {
+        if (width != PRUNING_SIZE) {
+            return true;
+        }
+        for (size_t moveWidth : moveWidths) {
+            if (moveWidth != PRUNING_SIZE) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+
+#endif //PRUNINGPOLICY_H
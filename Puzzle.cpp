@@ -0,0 +1,81 @@
+#include "Puzzle.h"
+#include "Chess.h"
+
+#include <algorithm>
+#include <filesystem>
+
+
+/**
+ * @brief Read one line from input stream without trailing carriage return
+ * @param inputStream input stream to read from
+ * @param line line to fill
+ * @return true if line was read
+ */
+static bool readLine(std::istream &inputStream, std::string &line) {
+    if (!std::getline(inputStream, line)) {
+        return false;
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+
+/**
+ * @brief Load puzzle from file
+ * @param fileName name of puzzle file
+ * @return loaded puzzle
+ */
+Puzzle Puzzle::load(const std::string &fileName) {
+    std::ifstream ifs(fileName);
+    if (!ifs.good()) {
+        throw std::runtime_error("Failed to open file");
+    }
+
+    Puzzle puzzle;
+    std::string color;
+    std::string depth;
+    puzzle.fileName = fileName;
+
+    if (!readLine(ifs, puzzle.FENCode) || !readLine(ifs, color) || !readLine(ifs, depth)) {
+        throw InvalidPuzzleFormat(fileName);
+    }
+    readLine(ifs, puzzle.link);
+    puzzle.colorOnMove = Chess::loadColor(color);
+
+    // depth has to be positive number
+    if (depth.empty() || !std::all_of(depth.begin(), depth.end(), ::isdigit) || std::stoul(depth) == 0) {
+        throw InvalidPuzzleFormat(fileName);
+    }
+    puzzle.searchDepth = std::stoul(depth);
+    return puzzle;
+}
+
+
+/**
+ * @brief Get puzzle files from paths, directories are replaced by their files sorted by name
+ * @param paths paths to puzzle files or directories with puzzle files
+ * @return puzzle file names
+ */
+std::vector<std::string> Puzzle::listFiles(const std::vector<std::string> &paths) {
+    std::vector<std::string> files;
+
+    for (const std::string &path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+
+        // directory may contain other files (README.md), puzzle files have no extension
+        std::vector<std::string> directoryFiles;
+        for (const auto &entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && !entry.path().has_extension()) {
+                directoryFiles.push_back(entry.path().string());
+            }
+        }
+        std::sort(directoryFiles.begin(), directoryFiles.end());
+        files.insert(files.end(), directoryFiles.begin(), directoryFiles.end());
+    }
+    return files;
+}
@@ -0,0 +1,37 @@
+#ifndef PUZZLE_H
+#define PUZZLE_H
+
+#include <string>
+#include <vector>
+#include "Types.h"
+
+
+/**
+ * @brief Struct representing puzzle file in inputs/FEN format (FEN, color on move, number of moves, link).
+ */
+struct Puzzle {
+    std::string fileName;  ///< Name of the puzzle file
+    std::string FENCode;   ///< FEN code of game
+    Color colorOnMove;     ///< Color of player to move
+    size_t searchDepth;    ///< Number of moves to checkmate
+    std::string link;      ///< Link to game, might be empty
+
+
+    /**
+     * @brief Load puzzle from file
+     * @param fileName name of puzzle file
+     * @return loaded puzzle
+     */
+    static Puzzle load(const std::string &fileName);
+
+
+    /**
+     * @brief Get puzzle files from paths, directories are replaced by their files sorted by name
+     * @param paths paths to puzzle files or directories with puzzle files
+     * @return puzzle file names
+     */
+    static std::vector<std::string> listFiles(const std::vector<std::string> &paths);
+};
+
+
+#endif //PUZZLE_H
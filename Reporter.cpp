@@ -0,0 +1,84 @@
+#include "Reporter.h"
+#include "Chess.h"
+
+#include <iomanip>
+
+
+/**
+ * @brief Print warning if pruned result might not be valid
+ * @param pruningPolicy pruning of the search
+ */
+void ConsoleReporter::searchStarted(const PruningPolicy &pruningPolicy) {
+    // pruned attacker moves cannot fabricate checkmate
+    if (pruningPolicy.prunesDefender() && !pruningPolicy.verify) {
+        os_ << "You have defined pruning size, only limited number of moves will be searched.\n";
+        os_ << "This can lead to invalid results in some cases.\n";
+        os_ << '\n';
+    }
+}
+
+
+/**
+ * @brief Print found checkmate or material evaluation and good move
+ * @param result result of the search
+ */
+void ConsoleReporter::searchFinished(const SearchResult &result) {
+    if (result.checkMate) {
+        os_ << "Checkmate founded!\n";
+        os_ << "Start: " << result.bestMove << '\n';
+        os_ << '\n';
+    }
+    else {
+        os_ << "No checkmate founded, ";
+        printGameAnalysis(result.score);
+        os_ << "Good updatePosition could be: " << result.bestMove;
+        os_ << '\n';
+    }
+    os_.flush();
+}
+
+
+/**
+ * @brief print game analysis
+ * @param evaluation evaluation of game position
+ */
+void ConsoleReporter::printGameAnalysis(int evaluation) {
+    if (evaluation > 0) {
+        os_ << "WHITE has material advantage.\n";
+    }
+    else if (evaluation < 0) {
+        os_ << "BLACK has material advantage.\n";
+    }
+    else {
+        os_ << "NO player has material advantage\n";
+    }
+}
+
+
+/**
+ * @brief Print statistics of finished search
+ * @param result result of the search
+ */
+void StatsReporter::searchFinished(const SearchResult &result) {
+    const SearchStats &stats = result.stats;
+    os_ << "nodes " << stats.nodes << ", reductions " << stats.reductions << ", re-searches " << stats.reSearches
+        << ", tablebase hits " << stats.tablebaseHits << '/' << stats.tablebaseProbes << '\n';
+    if (ALLOCATION_STATS_ENABLED) {
+        os_ << "allocations " << stats.allocations.allocations << ", deallocations " << stats.allocations.deallocations
+            << ", allocated bytes " << stats.allocations.bytes << ", peak bytes " << stats.allocations.peakBytes << '\n';
+    }
+    if (!PLY_STATS_ENABLED) {
+        os_ << "per-ply statistics are disabled, build with -DCHECKMATE_PLY_STATS=ON" << std::endl;
+        return;
+    }
+
+    os_ << "ply\tnodes\tleaves\tbranching\tmoves\tcutoffs\tfirst cutoffs\tmates\n";
+    for (size_t ply = 0; ply < stats.plies.size(); ++ply) {
+        const PlyStats &plyStats = stats.plies[ply];
+        os_ << ply << '\t' << plyStats.nodes << '\t' << plyStats.leaves << '\t' << std::fixed << std::setprecision(2)
+            << stats.branchingFactor(ply) << '\t' << plyStats.averageMoves() << '\t'
+            << std::setprecision(1) << 100 * plyStats.cutoffRate() << "%\t"
+            << 100 * plyStats.firstMoveCutoffRate() << "%\t" << plyStats.mates << '\n';
+    }
+    os_.flush();
+}
@@ -0,0 +1,94 @@
+#ifndef REPORTER_H
+#define REPORTER_H
+
+#include <iostream>
+#include "PruningPolicy.h"
+#include "SearchResult.h"
+
+
+/**
+ * @brief Interface for reporting progress and results of findCheckMate, search itself prints nothing.
+ */
+class SearchReporter {
+public:
+    virtual ~SearchReporter() = default;
+
+
+    /**
+     * @brief Called before search starts
+     * @param pruningPolicy pruning of the search
+     */
+    virtual void searchStarted(const PruningPolicy &/*pruningPolicy*/) {}
+
+
+    /**
+     * @brief Called after search ends
+     * @param result result of the search
+     */
+    virtual void searchFinished(const SearchResult &/*result*/) {}
+};
+
+
+/**
+ * @brief Reporter printing human readable results to output stream.
+ */
+class ConsoleReporter : public SearchReporter {
+private:
+    std::ostream &os_;  ///< Stream to print to
+
+public:
+    /**
+     * @brief Constructor
+     * @param os stream to print to
+     */
+    explicit ConsoleReporter(std::ostream &os = std::cout) : os_(os) {}
+
+
+    /**
+     * @brief Print warning if pruned result might not be valid
+     * @param pruningPolicy pruning of the search
+     */
+    void searchStarted(const PruningPolicy &pruningPolicy) override;
+
+
+    /**
+     * @brief Print found checkmate or material evaluation and good move
+     * @param result result of the search
+     */
+    void searchFinished(const SearchResult &result) override;
+
+
+private:
+    /**
+     * @brief print game analysis
+     * @param evaluation evaluation of game position
+     */
+    void printGameAnalysis(int evaluation);
+};
+
+
+/**
+ * @brief Reporter printing summary of search statistics: totals and table of per-ply counters (nodes, leaves,
+ * effective branching factor, average generated moves, cutoff rates and found checkmates).
+ */
+class StatsReporter : public SearchReporter {
+private:
+    std::ostream &os_;  ///< Stream to print to
+
+public:
+    /**
+     * @brief Constructor
+     * @param os stream to print to
+     */
+    explicit StatsReporter(std::ostream &os = std::cout) : os_(os) {}
+
+
+    /**
+     * @brief Print statistics of finished search
+     * @param result result of the search
+     */
+    void searchFinished(const SearchResult &result) override;
+};
+
+
+#endif //REPORTER_H
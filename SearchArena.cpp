@@ -0,0 +1,56 @@
+#include "SearchArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+/**
+ * @brief Get number of bytes reserved by chunks
+ * @return reserved bytes
+ */
+size_t SearchArena::reserved() const {
+    size_t bytes = 0;
+    for (const Chunk &chunk : chunks_) {
+        bytes += chunk.size;
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief Allocate memory by moving allocation pointer, the next chunk is used if current one is full
+ * @param bytes size of memory
+ * @param alignment alignment of memory
+ * @return allocated memory
+ */
+void *SearchArena::do_allocate(size_t bytes, size_t alignment) {
+    while (true) {
+        if (top_.chunk < chunks_.size()) {
+            Chunk &chunk = chunks_[top_.chunk];
+            auto address = reinterpret_cast<std::uintptr_t>(chunk.memory.get()) + top_.offset;
+            size_t offset = top_.offset + (alignment - address % alignment) % alignment;
+            if (offset + bytes <= chunk.size) {
+                top_.offset = offset + bytes;
+                return chunk.memory.get() + offset;
+            }
+
+            // chunks after the current one are free, they are reused if the request fits
+            if (top_.chunk + 1 < chunks_.size() && chunks_[top_.chunk + 1].size >= bytes + alignment) {
+                top_ = {top_.chunk + 1, 0};
+                continue;
+            }
+        }
+
+        // new chunk follows the current one, too small free chunk is replaced
+        size_t index = chunks_.empty() ? 0 : top_.chunk + 1;
+        Chunk chunk{std::make_unique_for_overwrite<std::byte[]>(std::max(chunkSize_, bytes + alignment)),
+                    std::max(chunkSize_, bytes + alignment)};
+        if (index < chunks_.size()) {
+            chunks_[index] = std::move(chunk);
+        }
+        else {
+            chunks_.push_back(std::move(chunk));
+        }
+        top_ = {index, 0};
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef SEARCHARENA_H
+#define SEARCHARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+static const size_t ARENA_CHUNK_SIZE = 256 * 1024;  ///< Size of arena chunk in bytes, bigger requests get own chunk
+
+
+/**
+ * @brief Bump allocator of search scratch memory (move and position lists) owned by one Chess instance.
+ * @details Allocation only moves pointer in current chunk, deallocation does nothing. ArenaFrame marks the pointer
+ * when minimax node is entered and rewinds it when the node returns, so all lists of the node and its subtree are
+ * freed at once. Chunks are kept for the next searches, so steady search does not call malloc for scratch data.
+ * Outside of frames scratch() is the default resource, so lists which outlive the search use ordinary heap.
+ */
+class SearchArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Position of allocation pointer
+     */
+    struct Mark {
+        size_t chunk = 0;   ///< Index of current chunk
+        size_t offset = 0;  ///< Used bytes of current chunk
+    };
+
+
+    /**
+     * @brief Constructor, the first chunk is allocated with the first allocation
+     * @param chunkSize size of chunk in bytes
+     */
+    explicit SearchArena(size_t chunkSize = ARENA_CHUNK_SIZE) : chunkSize_(chunkSize) {}
+
+
+    /**
+     * @brief Copy constructor, scratch memory is not copied -> copy is empty arena with the same chunk size
+     * @param other copied arena
+     */
+    SearchArena(const SearchArena &other) : SearchArena(other.chunkSize_) {}
+
+
+    /**
+     * @brief Copy assignment, scratch memory is not copied -> arena is kept
+     * @return this arena
+     */
+    SearchArena &operator=(const SearchArena &) {
+        return *this;
+    }
+
+
+    /**
+     * @brief Get resource for scratch lists
+     * @return this arena inside a frame, default resource otherwise
+     */
+    std::pmr::memory_resource *scratch() {
+        return frames_ > 0 ? this : std::pmr::get_default_resource();
+    }
+
+
+    /**
+     * @brief Get number of bytes reserved by chunks
+     * @return reserved bytes
+     */
+    size_t reserved() const;
+
+
+private:
+    friend class ArenaFrame;
+
+    /**
+     * @brief Chunk of memory
+     */
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;  ///< Memory of chunk
+        size_t size;                          ///< Size of memory in bytes
+    };
+
+    std::vector<Chunk> chunks_;  ///< Chunks, those after the current one are free
+    Mark top_;                   ///< Allocation pointer
+    size_t chunkSize_;           ///< Size of newly allocated chunk
+    size_t frames_ = 0;          ///< Number of open frames
+
+
+    /**
+     * @brief Allocate memory by moving allocation pointer, the next chunk is used if current one is full
+     * @param bytes size of memory
+     * @param alignment alignment of memory
+     * @return allocated memory
+     */
+    void *do_allocate(size_t bytes, size_t alignment) override;
+
+
+    /**
+     * @brief Memory is freed by rewinding frame, so single deallocation does nothing
+     */
+    void do_deallocate(void *, size_t, size_t) override {}
+
+
+    /**
+     * @brief Compare resources, memory of arena can be freed only by the same arena
+     * @param other other resource
+     * @return true if other is this arena
+     */
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+
+/**
+ * @brief Scope of scratch memory of one search node, memory allocated inside the frame is freed when it ends
+ */
+class ArenaFrame {
+private:
+    SearchArena &arena_;      ///< Arena of the frame
+    SearchArena::Mark mark_;  ///< Allocation pointer when frame started
+
+public:
+    /**
+     * @brief Constructor, marks allocation pointer
+     * @param arena arena of search
+     */
+    explicit ArenaFrame(SearchArena &arena) : arena_(arena), mark_(arena.top_) {
+        ++arena_.frames_;
+    }
+
+
+    /**
+     * @brief Destructor, rewinds allocation pointer -> memory allocated in the frame is free
+     */
+    ~ArenaFrame() {
+        --arena_.frames_;
+        arena_.top_ = mark_;
+    }
+
+
+    ArenaFrame(const ArenaFrame &) = delete;
+    ArenaFrame &operator=(const ArenaFrame &) = delete;
+};
+
+
+#endif //SEARCHARENA_H
@@ -0,0 +1,84 @@
+#ifndef SEARCHLIMITS_H
+#define SEARCHLIMITS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+static const size_t SEARCH_POLL_INTERVAL = 64;    ///< Number of nodes between checks of deadline and stop flag
+
+
+/**
+ * @brief Enum class representing how the last search ended.
+ */
+enum class SearchStatus {
+    COMPLETED,   ///< Search finished, result is exact
+    NODE_LIMIT,  ///< Search reached maximal number of nodes
+    TIMED_OUT,   ///< Search reached deadline
+    STOPPED      ///< Search was stopped by stop flag
+};
+
+
+/**
+ * @brief Get name of search status
+ * @param status status of search
+ * @return lower case name of status
+ */
+inline const char *searchStatusName(SearchStatus status) {
+    switch (status) {
+        case SearchStatus::NODE_LIMIT:
+            return "node-limit";
+        case SearchStatus::TIMED_OUT:
+            return "timed-out";
+        case SearchStatus::STOPPED:
+            return "stopped";
+        default:
+            return "completed";
+    }
+}
+
+
+/**
+ * @brief Struct with limits of one findCheckMate call, search is interrupted when any limit is reached.
+ * @details Node limit is checked in every node, deadline and stop flag every pollInterval nodes. Interrupted search
+ * keeps checkmate proven by already finished root moves and the best finished root move.
+ */
+struct SearchLimits {
+    using clock = std::chrono::steady_clock;
+
+    size_t maxNodes = 0;                          ///< Maximal number of nodes, 0 = unlimited
+    std::optional<clock::time_point> deadline;    ///< Wall-clock deadline, empty = unlimited
+    const std::atomic<bool> *stopFlag = nullptr;  ///< Search stops when flag is set by another thread
+    size_t pollInterval = SEARCH_POLL_INTERVAL;   ///< Number of nodes between checks of deadline and stop flag
+
+
+    /**
+     * @brief Create limits with deadline after time from now
+     * @param time time for search
+     * @return search limits
+     */
+    static SearchLimits timeLimit(std::chrono::milliseconds time) {
+        SearchLimits limits;
+        limits.deadline = clock::now() + time;
+        return limits;
+    }
+
+
+    /**
+     * @brief Check if deadline or stop flag ended the search, called every pollInterval nodes
+     * @return status of search, COMPLETED if search can continue
+     */
+    SearchStatus poll() const {
+        if (stopFlag != nullptr && stopFlag->load(std::memory_order_relaxed)) {
+            return SearchStatus::STOPPED;
+        }
+        else if (deadline && clock::now() >= *deadline) {
+            return SearchStatus::TIMED_OUT;
+        }
+        return SearchStatus::COMPLETED;
+    }
+};
+
+
+#endif //SEARCHLIMITS_H
@@ -0,0 +1,35 @@
+#ifndef SEARCHRESULT_H
+#define SEARCHRESULT_H
+
+#include "Types.h"
+#include "SearchLimits.h"
+#include "SearchStats.h"
+
+
+/**
+ * @brief Struct with result of one findCheckMate call.
+ */
+struct SearchResult {
+    bool checkMate = false;                         ///< True if attacker can give checkmate
+    size_t mateDistance = 0;                        ///< Number of attacker moves to checkmate, 0 if not found
+    piece_move bestMove;                            ///< Best root move, empty if no root move was finished
+    piece_moves principalVariation;                 ///< Expected moves of both players starting with bestMove
+    int score = 0;                                  ///< Evaluation for white, checkmate at ply p is +-(CHECKMATE_SCORE - p)
+    SearchStats stats;                              ///< Statistics of search
+    double time = 0;                                ///< Search time in milliseconds
+    size_t depth = 0;                               ///< Number of moves searched, 0 if search was interrupted
+    SearchStatus status = SearchStatus::COMPLETED;  ///< How the search ended
+    bool cached = false;                            ///< Result was read from solution cache, no node was searched
+
+
+    /**
+     * @brief Check if checkmate was found
+     * @return true if attacker can give checkmate
+     */
+    explicit operator bool() const {
+        return checkMate;
+    }
+};
+
+
+#endif //SEARCHRESULT_H
@@ -0,0 +1,105 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstddef>
+#include <vector>
+#include "AllocationTracker.h"
+
+// per-ply counters cost time in every node, so they are compiled only with CHECKMATE_PLY_STATS
+#ifdef CHECKMATE_PLY_STATS
+#define COUNT_PLY_STAT(stats, ply, counter, value) ((stats).atPly(ply).counter += (value))
+static const bool PLY_STATS_ENABLED = true;   ///< Per-ply statistics are collected
+#else
+#define COUNT_PLY_STAT(stats, ply, counter, value) ((void) 0)
+static const bool PLY_STATS_ENABLED = false;  ///< Per-ply statistics are not compiled in
+#endif
+
+
+/**
+ * @brief Struct holding statistics of nodes at one ply (number of half-moves from the root).
+ */
+struct PlyStats {
+    size_t nodes = 0;             ///< Number of visited minimax nodes
+    size_t leaves = 0;            ///< Number of nodes evaluated by deepEvaluation
+    size_t expanded = 0;          ///< Number of nodes whose moves were generated
+    size_t generatedMoves = 0;    ///< Number of moves generated in expanded nodes
+    size_t cutoffs = 0;           ///< Number of expanded nodes cut off by alpha-beta pruning
+    size_t firstMoveCutoffs = 0;  ///< Number of cutoffs caused by the first move
+    size_t mates = 0;             ///< Number of checkmated positions found
+
+
+    /**
+     * @brief Get average number of generated moves per expanded node
+     * @return average number of moves, 0 if no node was expanded
+     */
+    double averageMoves() const {
+        return expanded > 0 ? static_cast<double>(generatedMoves) / expanded : 0;
+    }
+
+
+    /**
+     * @brief Get part of expanded nodes which were cut off
+     * @return cutoff rate between 0 and 1
+     */
+    double cutoffRate() const {
+        return expanded > 0 ? static_cast<double>(cutoffs) / expanded : 0;
+    }
+
+
+    /**
+     * @brief Get part of cutoffs caused by the first move, measures quality of move ordering
+     * @return first-move cutoff rate between 0 and 1
+     */
+    double firstMoveCutoffRate() const {
+        return cutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / cutoffs : 0;
+    }
+};
+
+
+/**
+ * @brief Struct holding statistics collected during one findCheckMate call.
+ */
+struct SearchStats {
+    size_t nodes = 0;             ///< Number of visited minimax nodes
+    size_t reductions = 0;        ///< Number of attacker moves searched with reduced depth
+    size_t reSearches = 0;        ///< Number of reduced moves which failed high and were searched again with full depth
+    size_t tablebaseProbes = 0;   ///< Number of positions looked up in mapped tablebase
+    size_t tablebaseHits = 0;     ///< Number of probed positions evaluated by tablebase instead of search
+    std::vector<PlyStats> plies;  ///< Statistics by ply, empty unless built with CHECKMATE_PLY_STATS
+    AllocationStats allocations;  ///< Heap allocations of the search, zero unless built with CHECKMATE_ALLOC_STATS
+
+
+    /**
+     * @brief Reset all statistics to zero
+     */
+    void reset() {
+        *this = SearchStats();
+    }
+
+
+    /**
+     * @brief Get statistics of ply, plies are added when needed
+     * @param ply number of half-moves from the root
+     * @return statistics of ply
+     */
+    PlyStats &atPly(size_t ply) {
+        if (ply >= plies.size()) {
+            plies.resize(ply + 1);
+        }
+        return plies[ply];
+    }
+
+
+    /**
+     * @brief Get effective branching factor between ply and the next one
+     * @param ply number of half-moves from the root
+     * @return ratio of nodes at the next ply and at ply, 0 if there is no next ply
+     */
+    double branchingFactor(size_t ply) const {
+        return ply + 1 < plies.size() && plies[ply].nodes > 0 ?
+               static_cast<double>(plies[ply + 1].nodes) / plies[ply].nodes : 0;
+    }
+};
+
+
+#endif //SEARCHSTATS_H
@@ -0,0 +1,172 @@
+#include "Socket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+/**
+ * @brief Throw exception for failed system call
+ * @param operation name of operation
+ */
+[[noreturn]] static void throwSystemError(const char *operation) {
+    throw std::system_error(errno, std::generic_category(), operation);
+}
+
+
+/**
+ * @brief Create address of socket file
+ * @param path path of socket file
+ * @return socket address
+ */
+static sockaddr_un socketAddress(const std::string &path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path is too long");
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+
+/**
+ * @brief Read exactly size bytes
+ * @param fd file descriptor to read from
+ * @param buffer buffer to fill
+ * @param size number of bytes to read
+ * @return false if connection was closed before first byte
+ */
+static bool readExactly(int fd, char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t count = ::read(fd, buffer + done, size - done);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        else if (count < 0) {
+            throwSystemError("read");
+        }
+        else if (count == 0) {
+            if (done == 0) {
+                return false;
+            }
+            throw std::runtime_error("Connection closed in the middle of message");
+        }
+        done += count;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write exactly size bytes
+ * @param fd file descriptor to write to
+ * @param buffer bytes to write
+ * @param size number of bytes to write
+ */
+static void writeExactly(int fd, const char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        // MSG_NOSIGNAL -> closed connection is reported by EPIPE instead of killing the process
+        ssize_t count = ::send(fd, buffer + done, size - done, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        else if (count < 0) {
+            throwSystemError("send");
+        }
+        done += count;
+    }
+}
+
+
+/**
+ * @brief Create socket listening on path, existing socket file is replaced
+ * @param path path of socket file
+ * @return file descriptor of listening socket
+ */
+int Socket::listen(const std::string &path) {
+    sockaddr_un address = socketAddress(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throwSystemError("socket");
+    }
+
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        throwSystemError("bind");
+    }
+    return fd;
+}
+
+
+/**
+ * @brief Connect to listening socket
+ * @param path path of socket file
+ * @return file descriptor of connected socket
+ */
+int Socket::connect(const std::string &path) {
+    sockaddr_un address = socketAddress(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throwSystemError("socket");
+    }
+
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        throwSystemError("connect");
+    }
+    return fd;
+}
+
+
+/**
+ * @brief Read one message
+ * @param fd file descriptor of connected socket
+ * @return message, empty if other side closed connection
+ */
+std::optional<std::string> Socket::readMessage(int fd) {
+    unsigned char header[4];
+    if (!readExactly(fd, reinterpret_cast<char *>(header), sizeof(header))) {
+        return std::nullopt;
+    }
+
+    size_t size = (size_t(header[0]) << 24) | (size_t(header[1]) << 16) | (size_t(header[2]) << 8) | header[3];
+    if (size > MAX_MESSAGE_SIZE) {
+        throw std::runtime_error("Message is too long");
+    }
+
+    std::string message(size, '\0');
+    if (size > 0 && !readExactly(fd, message.data(), size)) {
+        throw std::runtime_error("Connection closed in the middle of message");
+    }
+    return message;
+}
+
+
+/**
+ * @brief Write one message
+ * @param fd file descriptor of connected socket
+ * @param message message to write
+ */
+void Socket::writeMessage(int fd, const std::string &message) {
+    if (message.size() > MAX_MESSAGE_SIZE) {
+        throw std::runtime_error("Message is too long");
+    }
+
+    size_t size = message.size();
+    char header[4] = {static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                      static_cast<char>(size >> 8), static_cast<char>(size)};
+    writeExactly(fd, header, sizeof(header));
+    writeExactly(fd, message.data(), message.size());
+}
@@ -0,0 +1,50 @@
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include <optional>
+#include <string>
+
+static const char *const DEFAULT_SOCKET_PATH = "/tmp/checkmate_solver.sock";  ///< Socket of solver daemon
+static const size_t MAX_MESSAGE_SIZE = 1 << 20;                              ///< Maximal size of one message
+
+
+/**
+ * @brief Length-prefixed messages over Unix domain stream socket.
+ * @details Each message is 4-byte big-endian length followed by message text (one JSON object). Errors of system
+ * calls are reported by std::system_error.
+ */
+namespace Socket {
+    /**
+     * @brief Create socket listening on path, existing socket file is replaced
+     * @param path path of socket file
+     * @return file descriptor of listening socket
+     */
+    int listen(const std::string &path);
+
+
+    /**
+     * @brief Connect to listening socket
+     * @param path path of socket file
+     * @return file descriptor of connected socket
+     */
+    int connect(const std::string &path);
+
+
+    /**
+     * @brief Read one message
+     * @param fd file descriptor of connected socket
+     * @return message, empty if other side closed connection
+     */
+    std::optional<std::string> readMessage(int fd);
+
+
+    /**
+     * @brief Write one message
+     * @param fd file descriptor of connected socket
+     * @param message message to write
+     */
+    void writeMessage(int fd, const std::string &message);
+}
+
+
+#endif //SOCKET_H
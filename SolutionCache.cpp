@@ -0,0 +1,367 @@
+#include "SolutionCache.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char CACHE_MAGIC[8] = {'C', 'M', 'S', 'O', 'L', 'V', 'E', '\0'};  ///< First bytes of cache file
+static const std::uint32_t CACHE_VERSION = 2;                                   ///< Version of record layout
+
+
+/**
+ * @brief Header at the start of cache file
+ */
+struct CacheHeader {
+    char magic[8];             ///< CACHE_MAGIC
+    std::uint32_t version;     ///< CACHE_VERSION
+    std::uint32_t recordSize;  ///< Size of one record
+};
+
+
+/**
+ * @brief One cached result, moves are encoded by encodeMove
+ */
+struct CacheRecord {
+    std::uint64_t hash;                  ///< Hash of position
+    std::uint32_t checksum;              ///< Checksum of record with zero checksum field
+    std::int32_t score;                  ///< Evaluation for white
+    std::uint16_t mateDistance;          ///< Number of attacker moves to checkmate
+    std::uint8_t color;                  ///< Color on move
+    std::uint8_t depth;                  ///< Number of one color moves searched
+    std::uint8_t checkMate;              ///< 1 if attacker can give checkmate
+    std::uint8_t lineLength;             ///< Number of moves in line
+    std::uint16_t line[CACHE_MAX_LINE];  ///< Principal variation
+};
+
+static_assert(sizeof(CacheHeader) == 16, "Cache header has to be packed");
+static_assert(sizeof(CacheRecord) == 64, "Cache record has to fill one cache line");
+
+
+/**
+ * @brief Throw exception for failed system call
+ * @param operation name of operation
+ */
+[[noreturn]] static void throwSystemError(const char *operation) {
+    throw std::system_error(errno, std::generic_category(), operation);
+}
+
+
+/**
+ * @brief Exclusive lock of cache file held until the end of scope, excludes other processes
+ */
+class FileLock {
+public:
+    /**
+     * @brief Constructor, waits for the lock
+     * @param fd file descriptor of locked file
+     */
+    explicit FileLock(int fd) : fd_(fd) {
+        while (flock(fd_, LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                throwSystemError("flock");
+            }
+        }
+    }
+
+
+    /**
+     * @brief Destructor, releases the lock
+     */
+    ~FileLock() {
+        flock(fd_, LOCK_UN);
+    }
+
+
+    FileLock(const FileLock &) = delete;
+    FileLock &operator=(const FileLock &) = delete;
+
+
+private:
+    int fd_;  ///< Locked file
+};
+
+
+/**
+ * @brief Compute FNV-1a checksum of record, checksum field is treated as zero
+ * @param record record to check
+ * @return checksum
+ */
+static std::uint32_t recordChecksum(CacheRecord record) {
+    record.checksum = 0;
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&record);
+    std::uint32_t checksum = 2166136261u;
+    for (size_t i = 0; i < sizeof(record); ++i) {
+        checksum = (checksum ^ bytes[i]) * 16777619u;
+    }
+    return checksum;
+}
+
+
+/**
+ * @brief Encode move to 16 bits: from square, to square and promotion (0 = none, otherwise piece type + 1)
+ * @param move move to encode
+ * @return encoded move
+ */
+static std::uint16_t encodeMove(const piece_move &move) {
+    unsigned int from = move.first.x_ * 8 + move.first.y_;
+    unsigned int to = move.second.x_ * 8 + move.second.y_;
+
+    // transformTo_ of other moves than promotion is PAWN
+    unsigned int promotion = 0;
+    if (move.second.transformTo_ != PieceType::PAWN) {
+        promotion = static_cast<unsigned int>(move.second.transformTo_) + 1;
+    }
+    return static_cast<std::uint16_t>(from | to << 6 | promotion << 12);
+}
+
+
+/**
+ * @brief Decode move encoded by encodeMove
+ * @param code encoded move
+ * @return decoded move
+ */
+static piece_move decodeMove(std::uint16_t code) {
+    Position from((code & 63) / 8, code & 7);
+    Position to(((code >> 6) & 63) / 8, (code >> 6) & 7);
+    unsigned int promotion = code >> 12;
+    return {from, promotion == 0 ? to : Position(to, static_cast<PieceType>(promotion - 1))};
+}
+
+
+/**
+ * @brief Open cache file, new file is created if it does not exist
+ * @param path path of cache file
+ */
+SolutionCache::SolutionCache(const std::string &path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throwSystemError("open");
+    }
+
+    try {
+        // header is written by the first process, others check it
+        FileLock lock(fd_);
+        struct stat status{};
+        if (fstat(fd_, &status) != 0) {
+            throwSystemError("fstat");
+        }
+
+        CacheHeader header{};
+        if (status.st_size == 0) {
+            std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            header.version = CACHE_VERSION;
+            header.recordSize = sizeof(CacheRecord);
+            if (::write(fd_, &header, sizeof(header)) != sizeof(header)) {
+                throwSystemError("write");
+            }
+        }
+        else if (pread(fd_, &header, sizeof(header), 0) != sizeof(header) ||
+                 std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+                 header.version != CACHE_VERSION || header.recordSize != sizeof(CacheRecord)) {
+            throw InvalidCacheFile(path);
+        }
+    }
+    catch (...) {
+        ::close(fd_);
+        throw;
+    }
+    refresh();
+}
+
+
+/**
+ * @brief Destructor, unmaps and closes cache file
+ */
+SolutionCache::~SolutionCache() {
+    if (data_) {
+        munmap(const_cast<char *>(data_), mappedSize_);
+    }
+    ::close(fd_);
+}
+
+
+/**
+ * @brief Find result of search, records appended by other processes since last lookup are indexed on miss
+ * @param hash hash of searched position
+ * @param colorOnMove color of player on move
+ * @param searchDepth number of one color moves searched
+ * @return cached result without statistics and time, empty if position was not searched with this depth
+ */
+std::optional<SearchResult> SolutionCache::find(std::uint64_t hash, Color colorOnMove, size_t searchDepth) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        std::optional<SearchResult> result = lookup(hash, colorOnMove, searchDepth);
+        if (result) {
+            return result;
+        }
+    }
+
+    refresh();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return lookup(hash, colorOnMove, searchDepth);
+}
+
+
+/**
+ * @brief Append result of finished search, results which are already cached or too long are skipped
+ * @param hash hash of searched position
+ * @param colorOnMove color of player on move
+ * @param searchDepth number of one color moves searched
+ * @param result exact result of search
+ */
+void SolutionCache::store(std::uint64_t hash, Color colorOnMove, size_t searchDepth, const SearchResult &result) {
+    if (searchDepth > UINT8_MAX || result.principalVariation.size() > CACHE_MAX_LINE) {
+        return;
+    }
+
+    CacheRecord record{};
+    record.hash = hash;
+    record.score = result.score;
+    record.mateDistance = static_cast<std::uint16_t>(result.mateDistance);
+    record.color = static_cast<std::uint8_t>(colorOnMove);
+    record.depth = static_cast<std::uint8_t>(searchDepth);
+    record.checkMate = result.checkMate ? 1 : 0;
+    record.lineLength = static_cast<std::uint8_t>(result.principalVariation.size());
+    for (size_t i = 0; i < result.principalVariation.size(); ++i) {
+        record.line[i] = encodeMove(result.principalVariation[i]);
+    }
+    record.checksum = recordChecksum(record);
+
+    {
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        FileLock lock(fd_);
+
+        // another process might have stored the same result
+        refresh();
+        {
+            std::shared_lock<std::shared_mutex> readLock(mutex_);
+            if (lookup(hash, colorOnMove, searchDepth)) {
+                return;
+            }
+        }
+
+        // unfinished record of crashed writer is cut off, readers never index it
+        struct stat status{};
+        if (fstat(fd_, &status) != 0) {
+            throwSystemError("fstat");
+        }
+        size_t size = status.st_size;
+        size_t alignedSize = sizeof(CacheHeader) + (size - sizeof(CacheHeader)) / sizeof(CacheRecord) *
+                                                   sizeof(CacheRecord);
+        if (size != alignedSize && ftruncate(fd_, static_cast<off_t>(alignedSize)) != 0) {
+            throwSystemError("ftruncate");
+        }
+
+        // record is appended by one write, so it is never interleaved with records of other writers
+        ssize_t written;
+        while ((written = ::write(fd_, &record, sizeof(record))) < 0 && errno == EINTR) {
+        }
+        if (written != sizeof(record)) {
+            throwSystemError("write");
+        }
+    }
+    refresh();
+}
+
+
+/**
+ * @brief Get number of indexed results
+ * @return number of results which can be found
+ */
+size_t SolutionCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.size();
+}
+
+
+/**
+ * @brief Find record in index, mutex_ has to be locked
+ * @param hash hash of searched position
+ * @param colorOnMove color of player on move
+ * @param searchDepth number of one color moves searched
+ * @return cached result, empty if it is not indexed
+ */
+std::optional<SearchResult> SolutionCache::lookup(std::uint64_t hash, Color colorOnMove, size_t searchDepth) const {
+    auto it = index_.find(indexKey(hash, colorOnMove, searchDepth));
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+
+    CacheRecord record;
+    std::memcpy(&record, data_ + it->second, sizeof(record));
+    if (record.hash != hash || record.color != static_cast<std::uint8_t>(colorOnMove) || record.depth != searchDepth) {
+        return std::nullopt;
+    }
+
+    SearchResult result;
+    result.checkMate = record.checkMate != 0;
+    result.mateDistance = record.mateDistance;
+    result.score = record.score;
+    result.depth = searchDepth;
+    for (size_t i = 0; i < record.lineLength; ++i) {
+        result.principalVariation.push_back(decodeMove(record.line[i]));
+    }
+    result.bestMove = result.principalVariation.empty() ? piece_move() : result.principalVariation.front();
+    return result;
+}
+
+
+/**
+ * @brief Map grown file and index new records
+ */
+void SolutionCache::refresh() {
+    struct stat status{};
+    if (fstat(fd_, &status) != 0) {
+        throwSystemError("fstat");
+    }
+
+    // only whole records are mapped, record being appended is indexed by next refresh
+    size_t size = status.st_size;
+    size_t alignedSize = sizeof(CacheHeader) + (size - sizeof(CacheHeader)) / sizeof(CacheRecord) *
+                                               sizeof(CacheRecord);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (alignedSize <= mappedSize_) {
+        return;
+    }
+    void *data = mmap(nullptr, alignedSize, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        throwSystemError("mmap");
+    }
+    if (data_) {
+        munmap(const_cast<char *>(data_), mappedSize_);
+    }
+    data_ = static_cast<const char *>(data);
+    mappedSize_ = alignedSize;
+
+    // records with wrong checksum are skipped, the first record of position wins
+    for (size_t offset = std::max(indexedSize_, sizeof(CacheHeader)); offset < mappedSize_;
+         offset += sizeof(CacheRecord)) {
+        CacheRecord record;
+        std::memcpy(&record, data_ + offset, sizeof(record));
+        if (record.checksum == recordChecksum(record) && record.color <= 1 && record.lineLength <= CACHE_MAX_LINE) {
+            index_.emplace(indexKey(record.hash, static_cast<Color>(record.color), record.depth), offset);
+        }
+    }
+    indexedSize_ = mappedSize_;
+}
+
+
+/**
+ * @brief Get key of index
+ * @param hash hash of position
+ * @param colorOnMove color of player on move
+ * @param searchDepth search depth
+ * @return key of index, record is checked on lookup, so collisions only cause a miss
+ */
+std::uint64_t SolutionCache::indexKey(std::uint64_t hash, Color colorOnMove, size_t searchDepth) {
+    return hash ^ (static_cast<std::uint64_t>(searchDepth) << 1 | static_cast<std::uint64_t>(colorOnMove)) *
+                  0x9E3779B97F4A7C15ull;
+}
@@ -0,0 +1,106 @@
+#ifndef SOLUTIONCACHE_H
+#define SOLUTIONCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include "Types.h"
+#include "SearchResult.h"
+
+static const size_t CACHE_MAX_LINE = 21;  ///< Longest principal variation (in half-moves) stored in cache record
+
+
+/**
+ * @brief Persistent cache of search results shared by processes and threads, see USAGE.md for more info.
+ * @details File starts with header followed by fixed-size records, each record holds position hash, color on move,
+ * search depth, result, mate distance and principal variation. Records are only appended, each by one write under
+ * exclusive file lock, and protected by checksum, so readers can map the file and read records while another process
+ * appends. Readers index new records when lookup misses. File uses native byte order of the host.
+ */
+class SolutionCache {
+public:
+    /**
+     * @brief Open cache file, new file is created if it does not exist
+     * @param path path of cache file
+     */
+    explicit SolutionCache(const std::string &path);
+
+
+    /**
+     * @brief Destructor, unmaps and closes cache file
+     */
+    ~SolutionCache();
+
+
+    SolutionCache(const SolutionCache &) = delete;
+    SolutionCache &operator=(const SolutionCache &) = delete;
+
+
+    /**
+     * @brief Find result of search, records appended by other processes since last lookup are indexed on miss
+     * @param hash hash of searched position
+     * @param colorOnMove color of player on move
+     * @param searchDepth number of one color moves searched
+     * @return cached result without statistics and time, empty if position was not searched with this depth
+     */
+    std::optional<SearchResult> find(std::uint64_t hash, Color colorOnMove, size_t searchDepth);
+
+
+    /**
+     * @brief Append result of finished search, results which are already cached or too long are skipped
+     * @param hash hash of searched position
+     * @param colorOnMove color of player on move
+     * @param searchDepth number of one color moves searched
+     * @param result exact result of search
+     */
+    void store(std::uint64_t hash, Color colorOnMove, size_t searchDepth, const SearchResult &result);
+
+
+    /**
+     * @brief Get number of indexed results
+     * @return number of results which can be found
+     */
+    size_t size() const;
+
+
+private:
+    /**
+     * @brief Find record in index, mutex_ has to be locked
+     * @param hash hash of searched position
+     * @param colorOnMove color of player on move
+     * @param searchDepth number of one color moves searched
+     * @return cached result, empty if it is not indexed
+     */
+    std::optional<SearchResult> lookup(std::uint64_t hash, Color colorOnMove, size_t searchDepth) const;
+
+
+    /**
+     * @brief Map grown file and index new records
+     */
+    void refresh();
+
+
+    /**
+     * @brief Get key of index
+     * @param hash hash of position
+     * @param colorOnMove color of player on move
+     * @param searchDepth search depth
+     * @return key of index, record is checked on lookup, so collisions only cause a miss
+     */
+    static std::uint64_t indexKey(std::uint64_t hash, Color colorOnMove, size_t searchDepth);
+
+
+    int fd_ = -1;                                      ///< Cache file opened for reading and appending
+    const char *data_ = nullptr;                       ///< Mapped file
+    size_t mappedSize_ = 0;                            ///< Size of mapped part of file
+    size_t indexedSize_ = 0;                           ///< End of the last indexed record
+    std::unordered_map<std::uint64_t, size_t> index_;  ///< Offset of record by key
+    mutable std::shared_mutex mutex_;                  ///< Lookups share mapping, refresh replaces it
+    std::mutex writeMutex_;                            ///< File lock does not exclude threads sharing descriptor
+};
+
+
+#endif //SOLUTIONCACHE_H
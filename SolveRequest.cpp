@@ -0,0 +1,117 @@
+#include "SolveRequest.h"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+
+/**
+ * @brief Format result to JSON
+ * @return one-line JSON object
+ */
+std::string SolveResult::toJson() const {
+    JsonWriter writer;
+    writer.addRaw("id", id);
+
+    if (!error.empty()) {
+        return writer.add("error", error).str();
+    }
+    writer.add("checkmate", checkMate);
+    if (move.empty()) {
+        writer.addRaw("move", "null");
+    }
+    else {
+        writer.add("move", move);
+    }
+    if (checkMate) {
+        writer.add("mateIn", mateDistance);
+    }
+    else {
+        writer.addRaw("mateIn", "null");
+    }
+
+    std::string line;
+    for (const std::string &pvMove : principalVariation) {
+        line += (line.empty() ? "" : ",") + JsonObject::quote(pvMove);
+    }
+    writer.addRaw("pv", "[" + line + "]");
+    return writer.add("time", time).add("nodes", nodes).add("status", searchStatusName(status)).str();
+}
+
+
+/**
+ * @brief Create request from parsed JSON
+ * @param object parsed JSON request
+ * @return request
+ */
+SolveRequest SolveRequest::fromJson(const JsonObject &object) {
+    SolveRequest request;
+    request.id = object.getRaw("id");
+
+    // full FEN is accepted, only piece placement and side to move are used
+    std::istringstream fields(object.getString("fen"));
+    std::string side;
+    fields >> request.FENCode >> side;
+    if (request.FENCode.empty()) {
+        throw std::invalid_argument("Missing fen");
+    }
+
+    side = object.getString("side", side);
+    if (side == "w" || side == "b") {
+        side = side == "w" ? "white" : "black";
+    }
+    request.colorOnMove = side.empty() ? Color::WHITE : Chess::loadColor(side);
+
+    request.searchDepth = object.getSize("depth", SEARCH_DEPTH);
+    if (request.searchDepth == 0) {
+        throw std::invalid_argument("Depth has to be positive");
+    }
+
+    bool verify = object.getBool("options.verify", true);
+    bool attackerOnly = object.has("options.attackerPruning");
+    size_t width = object.getSize(attackerOnly ? "options.attackerPruning" : "options.pruning", PRUNING_SIZE);
+    if (width == 0) {
+        throw std::invalid_argument("Pruning has to be positive");
+    }
+    request.pruningPolicy = attackerOnly ? PruningPolicy::attackerOnly(width) : PruningPolicy::symmetric(width, verify);
+    request.lmrReduction = object.getSize("options.lmr", LMR_REDUCTION);
+    request.maxNodes = object.getSize("options.maxNodes", 0);
+    request.timeLimit = object.getSize("options.timeLimit", 0);
+    return request;
+}
+
+
+/**
+ * @brief Solve request
+ * @param chess chess used for search, previous game is cleared
+ * @return result of request
+ */
+SolveResult SolveRequest::solve(Chess &chess) const {
+    SolveResult result;
+    result.id = id;
+
+    try {
+        chess.clearGame();
+        chess.loadFENGame(FENCode);
+        chess.setLateMoveReductions(LMR_FULL_DEPTH_MOVES, lmrReduction);
+
+        // deadline starts when search starts, time spent in queue is not counted
+        SearchLimits limits = timeLimit > 0 ? SearchLimits::timeLimit(std::chrono::milliseconds(timeLimit)) :
+                              SearchLimits();
+        limits.maxNodes = maxNodes;
+        chess.setSearchLimits(limits);
+
+        SearchResult searchResult = chess.findCheckMate(colorOnMove, searchDepth, false, pruningPolicy);
+        result.checkMate = searchResult.checkMate;
+        result.move = chess.moveNotation(searchResult.bestMove);
+        result.principalVariation = chess.lineNotation(searchResult.principalVariation);
+        result.mateDistance = searchResult.mateDistance;
+        result.time = searchResult.time;
+        result.nodes = searchResult.stats.nodes;
+        result.status = searchResult.status;
+    }
+    catch (const std::exception &e) {
+        return SolveResult::failure(id, e.what());
+    }
+    return result;
+}
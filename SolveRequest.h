@@ -0,0 +1,81 @@
+#ifndef SOLVEREQUEST_H
+#define SOLVEREQUEST_H
+
+#include <string>
+#include "Chess.h"
+#include "Json.h"
+
+
+/**
+ * @brief Result of one solve request, formatted to one JSON line.
+ */
+struct SolveResult {
+    std::string id = "null";                        ///< JSON text of request id, copied from request
+    std::string error;                              ///< Error message, empty if request was solved
+    bool checkMate = false;                         ///< True if checkmate was found
+    std::string move;                               ///< Best move in coordinate notation, empty if there is no move
+    std::vector<std::string> principalVariation;    ///< Expected line in coordinate notation
+    size_t mateDistance = 0;                        ///< Number of attacker moves to checkmate, 0 if not found
+    double time = 0;                                ///< Search time in milliseconds
+    size_t nodes = 0;                               ///< Number of searched nodes
+    SearchStatus status = SearchStatus::COMPLETED;  ///< How the search ended
+
+
+    /**
+     * @brief Create result of request which cannot be solved
+     * @param id JSON text of request id
+     * @param error error message
+     * @return error result
+     */
+    static SolveResult failure(const std::string &id, const std::string &error) {
+        SolveResult result;
+        result.id = id;
+        result.error = error;
+        return result;
+    }
+
+
+    /**
+     * @brief Format result to JSON
+     * @return one-line JSON object
+     */
+    std::string toJson() const;
+};
+
+
+/**
+ * @brief One solve request: position, player on move, depth and search options.
+ * @details JSON request has members id (copied to result), fen, side ("white"/"black", default is side in FEN or
+ * white), depth (number of moves to checkmate) and optional options object with pruning (width of both players),
+ * attackerPruning (width of attacker only), verify (verify pruned results, default true), lmr (late move reduction),
+ * maxNodes (node budget) and timeLimit (time for search in milliseconds).
+ */
+struct SolveRequest {
+    std::string id = "null";                       ///< JSON text of request id
+    std::string FENCode;                           ///< Piece placement part of FEN
+    Color colorOnMove = Color::WHITE;              ///< Color of player to move
+    size_t searchDepth = SEARCH_DEPTH;             ///< Number of moves to checkmate
+    PruningPolicy pruningPolicy;                   ///< Pruning of search
+    size_t lmrReduction = LMR_REDUCTION;           ///< Late move reduction in moves, 0 = disabled
+    size_t maxNodes = 0;                           ///< Node budget, 0 = unlimited
+    size_t timeLimit = 0;                          ///< Time for search in milliseconds, 0 = unlimited
+
+
+    /**
+     * @brief Create request from parsed JSON
+     * @param object parsed JSON request
+     * @return request
+     */
+    static SolveRequest fromJson(const JsonObject &object);
+
+
+    /**
+     * @brief Solve request
+     * @param chess chess used for search, previous game is cleared
+     * @return result of request
+     */
+    SolveResult solve(Chess &chess) const;
+};
+
+
+#endif //SOLVEREQUEST_H
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <optional>
+#include <thread>
+#include "BlockingQueue.h"
+#include "SolveRequest.h"
+#include "ThreadPool.h"
+
+// streaming solver, reads one JSON request per line from stdin and writes one JSON result per line to stdout,
+// see USAGE.md for more info
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-j threads] < requests.ndjson" << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return number of solver threads, empty if arguments are invalid
+ */
+static std::optional<size_t> parseArguments(int argc, char *argv[]) {
+    size_t threadCount = 0;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (argument == "-j" && i + 1 < argc) {
+                threadCount = std::stoul(argv[++i]);
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    return threadCount;
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<size_t> threadCount = parseArguments(argc, argv);
+    if (!threadCount) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // pipeline: reader and parser (main thread) -> solvers (pool) -> formatter and writer (writer thread)
+    BlockingQueue<SolveResult> results;
+    std::thread writer([&results] {
+        while (std::optional<SolveResult> result = results.pop()) {
+            std::cout << result->toJson() << std::endl;
+        }
+    });
+
+    {
+        // one chess per worker -> no locking during search
+        ThreadPool pool(*threadCount);
+        std::vector<Chess> games(pool.size());
+
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+
+            std::string id = "null";
+            try {
+                JsonObject object = JsonObject::parse(line);
+                id = object.getRaw("id");
+                SolveRequest request = SolveRequest::fromJson(object);
+
+                pool.submit([&games, &results, request = std::move(request)](size_t worker) {
+                    results.push(request.solve(games[worker]));
+                });
+            }
+            catch (const std::exception &e) {
+                results.push(SolveResult::failure(id, e.what()));
+            }
+        }
+        pool.wait();
+    }
+
+    results.close();
+    writer.join();
+    return 0;
+}
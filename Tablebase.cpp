@@ -0,0 +1,459 @@
+#include "Tablebase.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char TABLEBASE_MAGIC[4] = {'C', 'M', 'T', 'B'};  ///< First bytes of table file
+static const std::uint16_t TABLEBASE_VERSION = 1;             ///< Version of table layout
+static const size_t KING_SQUARES = 10;                        ///< Number of squares of a1-d1-d4 triangle
+
+
+/**
+ * @brief Header at the start of table file
+ */
+struct TablebaseHeader {
+    char magic[4];             ///< TABLEBASE_MAGIC
+    std::uint16_t version;     ///< TABLEBASE_VERSION
+    std::uint16_t pieceCount;  ///< Number of pieces including kings
+    char material[8];          ///< Material name, padded by zeros
+};
+
+static_assert(sizeof(TablebaseHeader) == 16, "Tablebase header has to be packed");
+
+
+/**
+ * @brief Get index of square in a1-d1-d4 triangle
+ * @return index of each square, -1 if square is not in triangle
+ */
+static constexpr std::array<int, 64> triangleIndexes() {
+    std::array<int, 64> indexes{};
+    int next = 0;
+    for (int square = 0; square < 64; ++square) {
+        int rank = 7 - square / 8;
+        int column = square % 8;
+        indexes[square] = (column <= 3 && rank <= column) ? next++ : -1;
+    }
+    return indexes;
+}
+
+
+static constexpr std::array<int, 64> TRIANGLE_INDEXES = triangleIndexes();  ///< Index of king square in triangle
+
+
+/**
+ * @brief Get square of each triangle index
+ * @return squares of triangle
+ */
+static constexpr std::array<int, KING_SQUARES> triangleSquares() {
+    std::array<int, KING_SQUARES> squares{};
+    for (int square = 0; square < 64; ++square) {
+        if (TRIANGLE_INDEXES[square] >= 0) {
+            squares[TRIANGLE_INDEXES[square]] = square;
+        }
+    }
+    return squares;
+}
+
+
+static constexpr std::array<int, KING_SQUARES> TRIANGLE_SQUARES = triangleSquares();  ///< Square of triangle index
+
+
+/**
+ * @brief Get order of piece type, stronger pieces have lower order
+ * @param pieceType type of piece
+ * @return order of piece type
+ */
+static int strength(PieceType pieceType) {
+    switch (pieceType) {
+        case PieceType::QUEEN: return 0;
+        case PieceType::ROOK: return 1;
+        case PieceType::BISHOP: return 2;
+        case PieceType::KNIGHT: return 3;
+        default: return 4;
+    }
+}
+
+
+/**
+ * @brief Parse material name, e.g. KQKR or KBNK, sides might be in any order
+ * @param name material name
+ * @return material with strong side first
+ */
+Material Material::parse(const std::string &name) {
+    std::vector<PieceType> sides[2];
+    int side = -1;
+
+    for (char letter : name) {
+        switch (std::toupper(static_cast<unsigned char>(letter))) {
+            case 'K':
+                ++side;
+                continue;
+            case 'Q':
+                if (side >= 0 && side <= 1) {
+                    sides[side].push_back(PieceType::QUEEN);
+                }
+                break;
+            case 'R':
+                if (side >= 0 && side <= 1) {
+                    sides[side].push_back(PieceType::ROOK);
+                }
+                break;
+            case 'B':
+                if (side >= 0 && side <= 1) {
+                    sides[side].push_back(PieceType::BISHOP);
+                }
+                break;
+            case 'N':
+                if (side >= 0 && side <= 1) {
+                    sides[side].push_back(PieceType::KNIGHT);
+                }
+                break;
+            default:
+                throw InvalidMaterial(name);
+        }
+        if (side < 0 || side > 1) {
+            throw InvalidMaterial(name);
+        }
+    }
+    if (side != 1) {
+        throw InvalidMaterial(name);
+    }
+
+    bool swapped;
+    return fromSides(sides[0], sides[1], swapped);
+}
+
+
+/**
+ * @brief Create material from pieces of two sides, sides are swapped if the second one is stronger
+ * @param first pieces of the first side without king
+ * @param second pieces of the second side without king
+ * @param swapped set to true if second side is the strong side
+ * @return material with strong side first
+ */
+Material Material::fromSides(std::vector<PieceType> first, std::vector<PieceType> second, bool &swapped) {
+    auto stronger = [](PieceType a, PieceType b) { return strength(a) < strength(b); };
+    std::sort(first.begin(), first.end(), stronger);
+    std::sort(second.begin(), second.end(), stronger);
+
+    // stronger piece decides, then more pieces
+    auto compare = [](const std::vector<PieceType> &a, const std::vector<PieceType> &b) {
+        for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+            if (a[i] != b[i]) {
+                return strength(a[i]) < strength(b[i]);
+            }
+        }
+        return a.size() > b.size();
+    };
+    swapped = compare(second, first);
+    return swapped ? Material{second, first} : Material{first, second};
+}
+
+
+/**
+ * @brief Get material name
+ * @return name, e.g. KQKR
+ */
+std::string Material::name() const {
+    std::string name;
+    for (const std::vector<PieceType> *side : {&strong, &weak}) {
+        name += 'K';
+        for (PieceType pieceType : *side) {
+            name += "QRBN"[strength(pieceType)];
+        }
+    }
+    return name;
+}
+
+
+/**
+ * @brief Get signature of one side, each piece type has 4 bits with its count
+ * @param pieceType type of piece, king is not counted
+ * @return signature of one piece
+ */
+static std::uint32_t pieceSignature(PieceType pieceType) {
+    return 1u << (4 * strength(pieceType));
+}
+
+
+/**
+ * @brief Get signature of material, it identifies material without allocation
+ * @return counts of piece types of strong side in upper 16 bits and of weak side in lower 16 bits
+ */
+std::uint32_t Material::signature() const {
+    std::uint32_t sides[2] = {0, 0};
+    for (PieceType pieceType : strong) {
+        sides[0] += pieceSignature(pieceType);
+    }
+    for (PieceType pieceType : weak) {
+        sides[1] += pieceSignature(pieceType);
+    }
+    return sides[0] << 16 | sides[1];
+}
+
+
+/**
+ * @brief Get types of all pieces in piece order: strong king, strong pieces, weak king, weak pieces
+ * @return piece types
+ */
+std::vector<PieceType> Material::pieceTypes() const {
+    std::vector<PieceType> pieceTypes = {PieceType::KING};
+    pieceTypes.insert(pieceTypes.end(), strong.begin(), strong.end());
+    pieceTypes.push_back(PieceType::KING);
+    pieceTypes.insert(pieceTypes.end(), weak.begin(), weak.end());
+    return pieceTypes;
+}
+
+
+/**
+ * @brief Constructor, all positions are drawn
+ * @param material material of the endgame
+ */
+Tablebase::Tablebase(const Material &material) : material_(material) {
+    if (material.pieceCount() > TABLEBASE_MAX_PIECES) {
+        throw InvalidMaterial(material.name());
+    }
+
+    size_ = 2 * KING_SQUARES;
+    for (size_t i = 1; i < material.pieceCount(); ++i) {
+        size_ *= 64;
+    }
+    values_.assign(size_, TABLEBASE_DRAW);
+    entries_ = values_.data();
+}
+
+
+/**
+ * @brief Destructor, unmaps loaded table
+ */
+Tablebase::~Tablebase() {
+    if (mapping_) {
+        munmap(mapping_, mappingSize_);
+    }
+}
+
+
+/**
+ * @brief Move constructor, mapping is moved to new table
+ * @param other moved table
+ */
+Tablebase::Tablebase(Tablebase &&other) noexcept :
+        material_(std::move(other.material_)), values_(std::move(other.values_)), entries_(other.entries_),
+        size_(other.size_), mapping_(other.mapping_), mappingSize_(other.mappingSize_) {
+    other.mapping_ = nullptr;
+}
+
+
+/**
+ * @brief Move assignment, mapping is moved to this table
+ * @param other moved table
+ * @return this table
+ */
+Tablebase &Tablebase::operator=(Tablebase &&other) noexcept {
+    if (this != &other) {
+        if (mapping_) {
+            munmap(mapping_, mappingSize_);
+        }
+        material_ = std::move(other.material_);
+        values_ = std::move(other.values_);
+        entries_ = other.entries_;
+        size_ = other.size_;
+        mapping_ = other.mapping_;
+        mappingSize_ = other.mappingSize_;
+        other.mapping_ = nullptr;
+    }
+    return *this;
+}
+
+
+/**
+ * @brief Map table file to memory, entries are read directly from mapped file
+ * @param fileName name of table file
+ * @return loaded table
+ */
+Tablebase Tablebase::load(const std::string &fileName) {
+    int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status{};
+    if (fd < 0 || fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(TablebaseHeader)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw InvalidTablebaseFile(fileName);
+    }
+    size_t mappingSize = status.st_size;
+    void *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw InvalidTablebaseFile(fileName);
+    }
+
+    TablebaseHeader header{};
+    std::memcpy(&header, mapping, sizeof(header));
+    std::string name(header.material, strnlen(header.material, sizeof(header.material)));
+    try {
+        if (std::memcmp(header.magic, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC)) != 0 ||
+            header.version != TABLEBASE_VERSION) {
+            throw InvalidTablebaseFile(fileName);
+        }
+
+        // entries of generated table are replaced by mapped file
+        Tablebase tablebase(Material::parse(name));
+        if (tablebase.material_.pieceCount() != header.pieceCount ||
+            mappingSize != sizeof(TablebaseHeader) + tablebase.size_) {
+            throw InvalidTablebaseFile(fileName);
+        }
+        tablebase.values_ = std::vector<std::uint8_t>();
+        tablebase.entries_ = static_cast<const std::uint8_t *>(mapping) + sizeof(TablebaseHeader);
+        tablebase.mapping_ = mapping;
+        tablebase.mappingSize_ = mappingSize;
+        return tablebase;
+    }
+    catch (const std::exception &) {
+        munmap(mapping, mappingSize);
+        throw InvalidTablebaseFile(fileName);
+    }
+}
+
+
+/**
+ * @brief Save table to file: 16-byte header and one byte per position
+ * @param fileName name of table file
+ */
+void Tablebase::save(const std::string &fileName) const {
+    TablebaseHeader header{};
+    std::memcpy(header.magic, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC));
+    header.version = TABLEBASE_VERSION;
+    header.pieceCount = static_cast<std::uint16_t>(material_.pieceCount());
+    std::string name = material_.name();
+    std::memcpy(header.material, name.data(), std::min(name.size(), sizeof(header.material)));
+
+    std::ofstream ofs(fileName, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(entries_), static_cast<std::streamsize>(size_));
+    if (!ofs) {
+        throw std::runtime_error("Failed to write file " + fileName);
+    }
+}
+
+
+/**
+ * @brief Get index of position, squares are normalized by symmetry
+ * @param weakToMove true if weak side is on move
+ * @param squares squares of pieces in material piece order
+ * @return index of position
+ */
+size_t Tablebase::index(bool weakToMove, const int *squares) const {
+    // mirror columns, mirror rows and flip along diagonal so that strong king is in the triangle
+    int king = squares[0];
+    int mirror = (king % 8 > 3 ? 7 : 0) | (king / 8 < 4 ? 56 : 0);
+    king ^= mirror;
+    bool flip = 7 - king / 8 > king % 8;
+
+    size_t index = (weakToMove ? KING_SQUARES : 0);
+    for (size_t i = 0; i < material_.pieceCount(); ++i) {
+        int square = squares[i] ^ mirror;
+        square = flip ? (7 - square % 8) * 8 + (7 - square / 8) : square;
+        index = (i == 0) ? index + TRIANGLE_INDEXES[square] : index * 64 + square;
+    }
+    return index;
+}
+
+
+/**
+ * @brief Get position of index
+ * @param index index of position
+ * @param weakToMove set to true if weak side is on move
+ * @param squares filled with squares of pieces in material piece order
+ */
+void Tablebase::decode(size_t index, bool &weakToMove, int *squares) const {
+    for (size_t i = material_.pieceCount() - 1; i > 0; --i) {
+        squares[i] = static_cast<int>(index % 64);
+        index /= 64;
+    }
+    squares[0] = TRIANGLE_SQUARES[index % KING_SQUARES];
+    weakToMove = index >= KING_SQUARES;
+}
+
+
+/**
+ * @brief Map all table files in directory
+ * @param directory directory with table files
+ */
+Tablebases::Tablebases(const std::string &directory) {
+    for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == TABLEBASE_EXTENSION) {
+            Tablebase tablebase = Tablebase::load(entry.path().string());
+            std::uint32_t signature = tablebase.getMaterial().signature();
+            tables_.emplace(signature, std::move(tablebase));
+        }
+    }
+}
+
+
+/**
+ * @brief Get entry of position, colors are swapped and board is normalized by symmetry to match the table
+ * @param position probed position
+ * @return entry from view of side to move, empty if there is no table of the material
+ */
+std::optional<std::uint8_t> Tablebases::probe(const TablebasePosition &position) const {
+    // pieces of each color sorted as in material: king first, then the strongest pieces
+    size_t order[2][TABLEBASE_MAX_PIECES];
+    size_t counts[2] = {0, 0};
+    size_t kings[2] = {0, 0};
+    std::uint32_t sides[2] = {0, 0};
+    for (size_t i = 0; i < position.pieceCount; ++i) {
+        size_t side = position.colors[i] == Color::WHITE ? 0 : 1;
+        if (position.pieceTypes[i] == PieceType::PAWN) {
+            return std::nullopt;
+        }
+        order[side][counts[side]++] = i;
+        if (position.pieceTypes[i] == PieceType::KING) {
+            ++kings[side];
+        }
+        else {
+            sides[side] += pieceSignature(position.pieceTypes[i]);
+        }
+    }
+    auto rank = [&position](size_t piece) {
+        return position.pieceTypes[piece] == PieceType::KING ? -1 : strength(position.pieceTypes[piece]);
+    };
+    for (size_t side = 0; side < 2; ++side) {
+        std::sort(order[side], order[side] + counts[side], [&rank](size_t a, size_t b) { return rank(a) < rank(b); });
+
+        // exactly one king of each color
+        if (kings[side] != 1) {
+            return std::nullopt;
+        }
+    }
+
+    // tables are stored with strong side first -> white is the weak side if only swapped signature is found
+    bool swapped = false;
+    auto found = tables_.find(sides[0] << 16 | sides[1]);
+    if (found == tables_.end()) {
+        swapped = true;
+        found = tables_.find(sides[1] << 16 | sides[0]);
+    }
+    if (found == tables_.end()) {
+        return std::nullopt;
+    }
+
+    int squares[TABLEBASE_MAX_PIECES];
+    size_t piece = 0;
+    for (size_t side : {swapped ? 1 : 0, swapped ? 0 : 1}) {
+        for (size_t i = 0; i < counts[side]; ++i) {
+            squares[piece++] = position.squares[order[side][i]];
+        }
+    }
+    bool weakToMove = position.colorOnMove == (swapped ? Color::WHITE : Color::BLACK);
+    const Tablebase &tablebase = found->second;
+    return tablebase.value(tablebase.index(weakToMove, squares));
+}
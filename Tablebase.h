@@ -0,0 +1,311 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Types.h"
+
+static const size_t TABLEBASE_MAX_PIECES = 4;                 ///< Largest supported endgame including kings
+static const std::uint8_t TABLEBASE_DRAW = 0;                 ///< Nobody can force checkmate
+static const std::uint8_t TABLEBASE_ILLEGAL = 255;            ///< Pieces share square or side not on move is in check
+static const char *const TABLEBASE_EXTENSION = ".tb";         ///< Extension of table files
+static const char *const TABLEBASE_DIRECTORY = "tablebases";  ///< Default directory of table files
+
+
+/**
+ * @brief Pieces of pawnless endgame, e.g. KQKR. Strong side is listed first, pieces of each side are sorted from
+ * the strongest (queen, rook, bishop, knight), kings are not stored.
+ */
+struct Material {
+    std::vector<PieceType> strong;  ///< Pieces of strong side without king
+    std::vector<PieceType> weak;    ///< Pieces of weak side without king
+
+
+    /**
+     * @brief Parse material name, e.g. KQKR or KBNK, sides might be in any order
+     * @param name material name
+     * @return material with strong side first
+     */
+    static Material parse(const std::string &name);
+
+
+    /**
+     * @brief Create material from pieces of two sides, sides are swapped if the second one is stronger
+     * @param first pieces of the first side without king
+     * @param second pieces of the second side without king
+     * @param swapped set to true if second side is the strong side
+     * @return material with strong side first
+     */
+    static Material fromSides(std::vector<PieceType> first, std::vector<PieceType> second, bool &swapped);
+
+
+    /**
+     * @brief Get material name
+     * @return name, e.g. KQKR
+     */
+    std::string name() const;
+
+
+    /**
+     * @brief Get signature of material, it identifies material without allocation
+     * @return counts of piece types of strong side in upper 16 bits and of weak side in lower 16 bits
+     */
+    std::uint32_t signature() const;
+
+
+    /**
+     * @brief Get number of pieces including kings
+     * @return number of pieces
+     */
+    size_t pieceCount() const {
+        return 2 + strong.size() + weak.size();
+    }
+
+
+    /**
+     * @brief Get index of weak king in piece order: strong king, strong pieces, weak king, weak pieces
+     * @return index of weak king
+     */
+    size_t weakKing() const {
+        return 1 + strong.size();
+    }
+
+
+    /**
+     * @brief Get types of all pieces in piece order: strong king, strong pieces, weak king, weak pieces
+     * @return piece types
+     */
+    std::vector<PieceType> pieceTypes() const;
+};
+
+
+/**
+ * @brief Distance to mate table of one pawnless endgame, see USAGE.md for more info.
+ * @details Position is given by side to move and squares of pieces in material piece order (square = row * 8 +
+ * column, row 0 is the 8th rank). Positions are normalized by board symmetry so that strong king is in a1-d1-d4
+ * triangle, which makes the table 10 * 64^(n-1) entries per side to move. Each entry is one byte: TABLEBASE_DRAW,
+ * TABLEBASE_ILLEGAL or number of half-moves to checkmate + 1 from view of side to move. Odd number of half-moves means
+ * side to move gives checkmate, even number means it is checkmated.
+ */
+class Tablebase {
+public:
+    /**
+     * @brief Constructor, all positions are drawn
+     * @param material material of the endgame
+     */
+    explicit Tablebase(const Material &material);
+
+
+    /**
+     * @brief Destructor, unmaps loaded table
+     */
+    ~Tablebase();
+
+
+    Tablebase(const Tablebase &) = delete;
+    Tablebase &operator=(const Tablebase &) = delete;
+
+
+    /**
+     * @brief Move constructor, mapping is moved to new table
+     * @param other moved table
+     */
+    Tablebase(Tablebase &&other) noexcept;
+
+
+    /**
+     * @brief Move assignment, mapping is moved to this table
+     * @param other moved table
+     * @return this table
+     */
+    Tablebase &operator=(Tablebase &&other) noexcept;
+
+
+    /**
+     * @brief Map table file to memory, entries are read directly from mapped file
+     * @param fileName name of table file
+     * @return loaded table
+     */
+    static Tablebase load(const std::string &fileName);
+
+
+    /**
+     * @brief Save table to file: 16-byte header and one byte per position
+     * @param fileName name of table file
+     */
+    void save(const std::string &fileName) const;
+
+
+    /**
+     * @brief Get material of the endgame
+     * @return material
+     */
+    const Material &getMaterial() const {
+        return material_;
+    }
+
+
+    /**
+     * @brief Get number of entries
+     * @return number of entries
+     */
+    size_t size() const {
+        return size_;
+    }
+
+
+    /**
+     * @brief Get entry
+     * @param index index of position
+     * @return value of position
+     */
+    std::uint8_t value(size_t index) const {
+        return entries_[index];
+    }
+
+
+    /**
+     * @brief Get entries for generation, only generated tables can be written
+     * @return first entry
+     */
+    std::uint8_t *data() {
+        return values_.data();
+    }
+
+
+    /**
+     * @brief Get index of position, squares are normalized by symmetry
+     * @param weakToMove true if weak side is on move
+     * @param squares squares of pieces in material piece order
+     * @return index of position
+     */
+    size_t index(bool weakToMove, const int *squares) const;
+
+
+    /**
+     * @brief Get position of index
+     * @param index index of position
+     * @param weakToMove set to true if weak side is on move
+     * @param squares filled with squares of pieces in material piece order
+     */
+    void decode(size_t index, bool &weakToMove, int *squares) const;
+
+
+    /**
+     * @brief Create entry of position with checkmate
+     * @param plies number of half-moves to checkmate
+     * @return entry
+     */
+    static std::uint8_t fromPlies(size_t plies) {
+        return static_cast<std::uint8_t>(plies + 1);
+    }
+
+
+    /**
+     * @brief Get number of half-moves to checkmate
+     * @param value entry which is neither draw nor illegal
+     * @return number of half-moves to checkmate
+     */
+    static size_t plies(std::uint8_t value) {
+        return value - 1;
+    }
+
+
+    /**
+     * @brief Check if side to move gives checkmate
+     * @param value entry
+     * @return true if side to move wins
+     */
+    static bool isWin(std::uint8_t value) {
+        return value != TABLEBASE_DRAW && value != TABLEBASE_ILLEGAL && plies(value) % 2 == 1;
+    }
+
+
+    /**
+     * @brief Check if side to move is checkmated
+     * @param value entry
+     * @return true if side to move loses
+     */
+    static bool isLoss(std::uint8_t value) {
+        return value != TABLEBASE_DRAW && value != TABLEBASE_ILLEGAL && plies(value) % 2 == 0;
+    }
+
+
+private:
+    Material material_;                 ///< Material of the endgame
+    std::vector<std::uint8_t> values_;  ///< Entries of generated table, empty for loaded table
+    const std::uint8_t *entries_;       ///< Entries of all positions, in values_ or in mapped file
+    size_t size_ = 0;                   ///< Number of entries
+    void *mapping_ = nullptr;           ///< Mapped file of loaded table
+    size_t mappingSize_ = 0;            ///< Size of mapped file
+};
+
+
+/**
+ * @brief Pieces of position probed in tablebases, pieces might be in any order.
+ */
+struct TablebasePosition {
+    size_t pieceCount = 0;                       ///< Number of pieces including kings
+    Color colors[TABLEBASE_MAX_PIECES];          ///< Color of each piece
+    PieceType pieceTypes[TABLEBASE_MAX_PIECES];  ///< Type of each piece
+    int squares[TABLEBASE_MAX_PIECES];           ///< Square of each piece, square = row * 8 + column
+    Color colorOnMove = Color::WHITE;            ///< Color of player on move
+
+
+    /**
+     * @brief Add piece to position
+     * @param color color of piece
+     * @param pieceType type of piece
+     * @param square square of piece
+     * @return false if position has too many pieces for tablebases
+     */
+    bool add(Color color, PieceType pieceType, int square) {
+        if (pieceCount == TABLEBASE_MAX_PIECES) {
+            return false;
+        }
+        colors[pieceCount] = color;
+        pieceTypes[pieceCount] = pieceType;
+        squares[pieceCount++] = square;
+        return true;
+    }
+};
+
+
+/**
+ * @brief Set of tables mapped from one directory, probed by search.
+ */
+class Tablebases {
+public:
+    /**
+     * @brief Map all table files in directory
+     * @param directory directory with table files
+     */
+    explicit Tablebases(const std::string &directory);
+
+
+    /**
+     * @brief Get number of mapped tables
+     * @return number of tables
+     */
+    size_t size() const {
+        return tables_.size();
+    }
+
+
+    /**
+     * @brief Get entry of position, colors are swapped and board is normalized by symmetry to match the table
+     * @param position probed position
+     * @return entry from view of side to move, empty if there is no table of the material
+     */
+    std::optional<std::uint8_t> probe(const TablebasePosition &position) const;
+
+
+private:
+    std::unordered_map<std::uint32_t, Tablebase> tables_;  ///< Tables by material signature
+};
+
+
+#endif //TABLEBASE_H
@@ -0,0 +1,99 @@
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include "TablebaseGenerator.h"
+
+// generator of endgame tables, see USAGE.md for more info
+
+
+/**
+ * @brief Generator settings given on command line
+ */
+struct GeneratorSettings {
+    size_t threadCount = 0;                       ///< Number of worker threads, 0 = hardware threads
+    std::string directory = TABLEBASE_DIRECTORY;  ///< Directory of generated files
+    std::vector<std::string> materials;           ///< Materials to generate
+};
+
+
+/**
+ * @brief Print usage of program
+ * @param program name of program
+ */
+static void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [-j threads] [-o directory] <material>..." << std::endl;
+    std::cerr << "Example: " << program << " KQK KRK KBBK KBNK KQKR" << std::endl;
+}
+
+
+/**
+ * @brief Parse command line arguments
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return settings, empty if arguments are invalid
+ */
+static std::optional<GeneratorSettings> parseArguments(int argc, char *argv[]) {
+    GeneratorSettings settings;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "-j" && hasValue) {
+                settings.threadCount = std::stoul(argv[++i]);
+            }
+            else if (argument == "-o" && hasValue) {
+                settings.directory = argv[++i];
+            }
+            else if (!argument.empty() && argument[0] == '-') {
+                return std::nullopt;
+            }
+            else {
+                settings.materials.push_back(argument);
+            }
+        }
+    }
+    catch (const std::exception &) {
+        return std::nullopt;
+    }
+    if (settings.materials.empty()) {
+        return std::nullopt;
+    }
+    return settings;
+}
+
+
+int main(int argc, char *argv[]) {
+    std::optional<GeneratorSettings> settings = parseArguments(argc, argv);
+    if (!settings) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        TablebaseGenerator generator(settings->threadCount);
+        for (const std::string &material : settings->materials) {
+            generator.generate(Material::parse(material));
+        }
+
+        // tables reached by captures are saved too, probing needs them
+        std::filesystem::create_directories(settings->directory);
+        std::cout << "material\tpositions\twins\tlosses\tdraws\tlongest mate\tpasses\ttime ms\tpositions/s\n";
+        for (const auto &[name, generated] : generator.getTables()) {
+            generated.table.save((std::filesystem::path(settings->directory) / (name + TABLEBASE_EXTENSION)).string());
+
+            const TablebaseStats &stats = generated.stats;
+            std::cout << name << '\t' << stats.positions << '\t' << stats.wins << '\t' << stats.losses << '\t'
+                      << stats.draws << '\t' << (stats.maxPlies + 1) / 2 << '\t' << stats.passes << '\t'
+                      << std::fixed << std::setprecision(1) << stats.time << '\t'
+                      << std::setprecision(0) << generated.table.size() * stats.passes / (stats.time / 1000) << '\n';
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
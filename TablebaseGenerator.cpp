@@ -0,0 +1,410 @@
+#include "TablebaseGenerator.h"
+#include "Exception.h"
+#include "pieces/Bishop.h"
+#include "pieces/King.h"
+#include "pieces/Knight.h"
+#include "pieces/Queen.h"
+#include "pieces/Rook.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+static const size_t GENERATION_CHUNK = 1 << 14;  ///< Number of positions solved by one task
+
+
+/**
+ * @brief Moves of one piece type, taken from engine pieces
+ */
+struct PieceMoves {
+    std::span<const Vector2D> vectors;  ///< Move vectors of piece
+    bool slides = false;                ///< Piece moves any number of squares in direction of vector
+};
+
+
+/**
+ * @brief Table reached by capture of one piece
+ */
+struct CaptureTable {
+    const Tablebase *table = nullptr;  ///< Table of remaining pieces, nullptr if only kings remain
+    bool swapped = false;              ///< Weak side of generated table is strong side of reached table
+    std::vector<size_t> pieces;        ///< Piece of generated table for each piece of reached table
+};
+
+
+/**
+ * @brief Get moves of piece type
+ * @param pieceType type of piece, pawns are not supported
+ * @return moves of piece type
+ */
+static PieceMoves pieceMoves(PieceType pieceType) {
+    switch (pieceType) {
+        case PieceType::KING: return {King::getVectorMoves(), false};
+        case PieceType::QUEEN: return {Queen::getVectorMoves(), true};
+        case PieceType::ROOK: return {Rook::getVectorMoves(), true};
+        case PieceType::BISHOP: return {Bishop::getVectorMoves(), true};
+        case PieceType::KNIGHT: return {Knight::getVectorMoves(), false};
+        default: throw InvalidMaterial("with pawns");
+    }
+}
+
+
+/**
+ * @brief Position solver of one table, shared by worker threads.
+ */
+class Retrograde {
+public:
+    /**
+     * @brief Constructor
+     * @param table generated table
+     * @param captures table reached by capture of each piece
+     */
+    Retrograde(Tablebase &table, std::vector<CaptureTable> captures) :
+            table_(table), captures_(std::move(captures)), pieceCount_(table.getMaterial().pieceCount()),
+            weakKing_(table.getMaterial().weakKing()) {
+        for (PieceType pieceType : table.getMaterial().pieceTypes()) {
+            moves_.push_back(pieceMoves(pieceType));
+        }
+    }
+
+
+    /**
+     * @brief Find illegal and checkmated positions, other positions stay TABLEBASE_DRAW until they are solved
+     * @param index index of position
+     * @return true if position is illegal or checkmated
+     */
+    bool initialize(size_t index) const {
+        bool weakToMove;
+        int squares[TABLEBASE_MAX_PIECES];
+        table_.decode(index, weakToMove, squares);
+
+        // pieces share square or player who moved left king in check
+        std::uint64_t occupied = 0;
+        bool illegal = false;
+        for (size_t i = 0; i < pieceCount_; ++i) {
+            illegal = illegal || (occupied & (1ull << squares[i]));
+            occupied |= 1ull << squares[i];
+        }
+        illegal = illegal || kingAttacked(squares, !weakToMove);
+
+        std::uint8_t value = illegal ? TABLEBASE_ILLEGAL : TABLEBASE_DRAW;
+        if (!illegal && forEachMove(squares, weakToMove, [](std::uint8_t) { return false; }) == 0 &&
+            kingAttacked(squares, weakToMove)) {
+            value = Tablebase::fromPlies(0);
+        }
+        std::atomic_ref<std::uint8_t>(table_.data()[index]).store(value, std::memory_order_relaxed);
+        return value != TABLEBASE_DRAW;
+    }
+
+
+    /**
+     * @brief Solve position with checkmate in given number of half-moves, odd number is win of side to move, even
+     * number is loss
+     * @param index index of unsolved legal position
+     * @param plies number of half-moves to checkmate
+     * @return true if position was solved
+     */
+    bool solve(size_t index, size_t plies) const {
+        bool weakToMove;
+        int squares[TABLEBASE_MAX_PIECES];
+        table_.decode(index, weakToMove, squares);
+
+        // positions solved by the same pass have plies half-moves, so they are ignored
+        bool solved;
+        if (plies % 2 == 1) {
+            solved = false;
+            forEachMove(squares, weakToMove, [&solved, plies](std::uint8_t value) {
+                solved = Tablebase::isLoss(value) && Tablebase::plies(value) < plies;
+                return !solved;
+            });
+        }
+        else {
+            solved = true;
+            size_t moveCount = forEachMove(squares, weakToMove, [&solved, plies](std::uint8_t value) {
+                solved = Tablebase::isWin(value) && Tablebase::plies(value) < plies;
+                return solved;
+            });
+            solved = solved && moveCount > 0;
+        }
+
+        if (solved) {
+            std::atomic_ref<std::uint8_t>(table_.data()[index]).store(Tablebase::fromPlies(plies),
+                                                                      std::memory_order_relaxed);
+        }
+        return solved;
+    }
+
+
+    /**
+     * @brief Get entry of generated table, it might be written by another thread
+     * @param index index of position
+     * @return entry of position
+     */
+    std::uint8_t value(size_t index) const {
+        return std::atomic_ref<std::uint8_t>(table_.data()[index]).load(std::memory_order_relaxed);
+    }
+
+
+private:
+    /**
+     * @brief Check if piece attacks square
+     * @param piece index of piece
+     * @param squares squares of pieces, -1 for captured piece
+     * @param target attacked square
+     * @param occupied bitmask of occupied squares
+     * @return true if piece attacks target
+     */
+    bool attacks(size_t piece, const int *squares, int target, std::uint64_t occupied) const {
+        Vector2D vector(target / 8 - squares[piece] / 8, target % 8 - squares[piece] % 8);
+        if (!moves_[piece].slides) {
+            return std::find(moves_[piece].vectors.begin(), moves_[piece].vectors.end(), vector) !=
+                   moves_[piece].vectors.end();
+        }
+
+        // slider -> direction has to be one of its vectors and squares between have to be free
+        if (!vector.couldBlockCheck()) {
+            return false;
+        }
+        vector.normalize();
+        if (std::find(moves_[piece].vectors.begin(), moves_[piece].vectors.end(), vector) ==
+            moves_[piece].vectors.end()) {
+            return false;
+        }
+        int step = vector.moveX * 8 + vector.moveY;
+        for (int square = squares[piece] + step; square != target; square += step) {
+            if (occupied & (1ull << square)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    /**
+     * @brief Check if king of side is attacked
+     * @param squares squares of pieces, -1 for captured piece
+     * @param weak true for king of weak side
+     * @return true if king is in check
+     */
+    bool kingAttacked(const int *squares, bool weak) const {
+        std::uint64_t occupied = 0;
+        for (size_t i = 0; i < pieceCount_; ++i) {
+            if (squares[i] >= 0) {
+                occupied |= 1ull << squares[i];
+            }
+        }
+
+        int king = squares[weak ? weakKing_ : 0];
+        size_t first = weak ? 0 : weakKing_;
+        size_t last = weak ? weakKing_ : pieceCount_;
+        for (size_t piece = first; piece < last; ++piece) {
+            if (squares[piece] >= 0 && attacks(piece, squares, king, occupied)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    /**
+     * @brief Visit entries of positions after all legal moves
+     * @param squares squares of pieces
+     * @param weakToMove true if weak side is on move
+     * @param visit called with entry of each reached position from view of its side to move, returns false to stop
+     * @return number of visited moves
+     */
+    template<typename Visitor>
+    size_t forEachMove(const int *squares, bool weakToMove, Visitor visit) const {
+        size_t moveCount = 0;
+        size_t first = weakToMove ? weakKing_ : 0;
+        size_t last = weakToMove ? pieceCount_ : weakKing_;
+
+        for (size_t piece = first; piece < last; ++piece) {
+            for (const Vector2D &vector : moves_[piece].vectors) {
+                int x = squares[piece] / 8;
+                int y = squares[piece] % 8;
+
+                while (true) {
+                    x += vector.moveX;
+                    y += vector.moveY;
+                    if (x < 0 || x > 7 || y < 0 || y > 7) {
+                        break;
+                    }
+
+                    // own pieces and kings block the move, other pieces are captured
+                    int target = x * 8 + y;
+                    int victim = -1;
+                    for (size_t i = 0; i < pieceCount_; ++i) {
+                        victim = (squares[i] == target) ? static_cast<int>(i) : victim;
+                    }
+                    if (victim >= 0 && (victim == 0 || victim == static_cast<int>(weakKing_) ||
+                                        (static_cast<size_t>(victim) >= weakKing_) == weakToMove)) {
+                        break;
+                    }
+
+                    int next[TABLEBASE_MAX_PIECES];
+                    std::copy(squares, squares + pieceCount_, next);
+                    next[piece] = target;
+                    if (victim >= 0) {
+                        next[victim] = -1;
+                    }
+                    if (!kingAttacked(next, weakToMove)) {
+                        ++moveCount;
+                        if (!visit(reachedValue(next, weakToMove, victim))) {
+                            return moveCount;
+                        }
+                    }
+
+                    if (victim >= 0 || !moves_[piece].slides) {
+                        break;
+                    }
+                }
+            }
+        }
+        return moveCount;
+    }
+
+
+    /**
+     * @brief Get entry of position after move
+     * @param squares squares of pieces after move, -1 for captured piece
+     * @param weakMoved true if weak side made the move
+     * @param victim index of captured piece, -1 if move is not capture
+     * @return entry from view of side to move after move
+     */
+    std::uint8_t reachedValue(const int *squares, bool weakMoved, int victim) const {
+        if (victim < 0) {
+            return value(table_.index(!weakMoved, squares));
+        }
+
+        const CaptureTable &capture = captures_[victim];
+        if (capture.table == nullptr) {
+            return TABLEBASE_DRAW;
+        }
+        int reached[TABLEBASE_MAX_PIECES];
+        for (size_t i = 0; i < capture.pieces.size(); ++i) {
+            reached[i] = squares[capture.pieces[i]];
+        }
+        return capture.table->value(capture.table->index(capture.swapped ? weakMoved : !weakMoved, reached));
+    }
+
+
+    Tablebase &table_;                    ///< Generated table
+    std::vector<CaptureTable> captures_;  ///< Table reached by capture of each piece
+    std::vector<PieceMoves> moves_;       ///< Moves of each piece
+    size_t pieceCount_;                   ///< Number of pieces including kings
+    size_t weakKing_;                     ///< Index of weak king
+};
+
+
+/**
+ * @brief Run function for all indexes split between worker threads and wait until it is finished
+ * @param pool worker threads
+ * @param size number of indexes
+ * @param function function returning true if it changed position
+ * @return number of changed positions
+ */
+static size_t parallelFor(ThreadPool &pool, size_t size, const std::function<bool(size_t)> &function) {
+    std::atomic<size_t> changes = 0;
+    for (size_t begin = 0; begin < size; begin += GENERATION_CHUNK) {
+        pool.submit([&, begin](size_t) {
+            size_t chunkChanges = 0;
+            for (size_t index = begin; index < std::min(size, begin + GENERATION_CHUNK); ++index) {
+                chunkChanges += function(index) ? 1 : 0;
+            }
+            changes += chunkChanges;
+        });
+    }
+    pool.wait();
+    return changes;
+}
+
+
+/**
+ * @brief Generate table of material and all tables reachable by captures, tables are generated only once
+ * @param material material of the endgame, 3 or 4 pieces without pawns
+ * @return generated table
+ */
+const GeneratedTablebase &TablebaseGenerator::generate(const Material &material) {
+    auto found = tables_.find(material.name());
+    if (found != tables_.end()) {
+        return found->second;
+    }
+    if (material.pieceCount() < 3 || material.pieceCount() > TABLEBASE_MAX_PIECES) {
+        throw InvalidMaterial(material.name());
+    }
+
+    // each capture leads to smaller table, which is generated first
+    std::vector<CaptureTable> captures(material.pieceCount());
+    size_t maxReachedPlies = 0;
+    for (size_t victim = 1; victim < material.pieceCount(); ++victim) {
+        if (victim == material.weakKing()) {
+            continue;
+        }
+
+        std::vector<PieceType> sides[2] = {material.strong, material.weak};
+        std::vector<size_t> pieces[2] = {{0}, {material.weakKing()}};
+        for (size_t i = 1; i < material.pieceCount(); ++i) {
+            if (i != victim && i != material.weakKing()) {
+                pieces[i > material.weakKing()].push_back(i);
+            }
+        }
+        bool weakVictim = victim > material.weakKing();
+        size_t sideIndex = weakVictim ? victim - material.weakKing() - 1 : victim - 1;
+        sides[weakVictim].erase(sides[weakVictim].begin() + static_cast<long>(sideIndex));
+
+        CaptureTable &capture = captures[victim];
+        Material reached = Material::fromSides(sides[0], sides[1], capture.swapped);
+        capture.pieces = capture.swapped ? pieces[1] : pieces[0];
+        capture.pieces.insert(capture.pieces.end(), pieces[!capture.swapped].begin(), pieces[!capture.swapped].end());
+        if (reached.pieceCount() > 2) {
+            const GeneratedTablebase &generated = generate(reached);
+            capture.table = &generated.table;
+            maxReachedPlies = std::max(maxReachedPlies, generated.stats.maxPlies);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    GeneratedTablebase generated{Tablebase(material), {}};
+    Tablebase &table = generated.table;
+    Retrograde retrograde(table, captures);
+
+    // checkmates, then one pass for each number of half-moves until nothing changes and captures cannot help
+    parallelFor(pool_, table.size(), [&retrograde](size_t index) {
+        return retrograde.initialize(index);
+    });
+    generated.stats.passes = 1;
+
+    size_t lastChange = 0;
+    for (size_t plies = 1; plies < TABLEBASE_ILLEGAL - 1 && (plies <= lastChange + 2 || plies <= maxReachedPlies + 2);
+         ++plies) {
+        size_t changes = parallelFor(pool_, table.size(), [&retrograde, plies](size_t index) {
+            return retrograde.value(index) == TABLEBASE_DRAW && retrograde.solve(index, plies);
+        });
+        lastChange = changes > 0 ? plies : lastChange;
+        ++generated.stats.passes;
+    }
+
+    for (size_t index = 0; index < table.size(); ++index) {
+        std::uint8_t value = table.value(index);
+        if (value == TABLEBASE_ILLEGAL) {
+            continue;
+        }
+        ++generated.stats.positions;
+        if (value == TABLEBASE_DRAW) {
+            ++generated.stats.draws;
+            continue;
+        }
+        if (Tablebase::isWin(value)) {
+            ++generated.stats.wins;
+        }
+        else {
+            ++generated.stats.losses;
+        }
+        generated.stats.maxPlies = std::max(generated.stats.maxPlies, Tablebase::plies(value));
+    }
+    generated.stats.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return tables_.emplace(material.name(), std::move(generated)).first->second;
+}
@@ -0,0 +1,73 @@
+#ifndef TABLEBASEGENERATOR_H
+#define TABLEBASEGENERATOR_H
+
+#include <map>
+#include <string>
+#include "Tablebase.h"
+#include "ThreadPool.h"
+
+
+/**
+ * @brief Struct with statistics of one generated table.
+ */
+struct TablebaseStats {
+    size_t positions = 0;  ///< Number of legal positions
+    size_t wins = 0;       ///< Positions where side to move gives checkmate
+    size_t losses = 0;     ///< Positions where side to move is checkmated
+    size_t draws = 0;      ///< Positions where nobody can force checkmate
+    size_t maxPlies = 0;   ///< Longest checkmate in half-moves
+    size_t passes = 0;     ///< Number of passes over the table
+    double time = 0;       ///< Generation time in milliseconds
+};
+
+
+/**
+ * @brief Generated table and its statistics.
+ */
+struct GeneratedTablebase {
+    Tablebase table;       ///< Distance to mate table
+    TablebaseStats stats;  ///< Statistics of generation
+};
+
+
+/**
+ * @brief Generator of distance to mate tables by retrograde analysis, see USAGE.md for more info.
+ * @details Checkmated positions are found first, then pass n finds positions with checkmate in n half-moves: side
+ * to move wins if some move leads to position lost in n - 1 half-moves and loses if all moves lead to positions won
+ * in at most n - 1 half-moves. Captures lead to smaller tables, which are generated first. Each pass is split between
+ * worker threads, entries written in pass n are never read by the same pass. Moves are generated from move vectors
+ * of the engine pieces.
+ */
+class TablebaseGenerator {
+public:
+    /**
+     * @brief Constructor, starts worker threads
+     * @param threadCount number of worker threads, 0 means number of hardware threads
+     */
+    explicit TablebaseGenerator(size_t threadCount = 0) : pool_(threadCount) {}
+
+
+    /**
+     * @brief Generate table of material and all tables reachable by captures, tables are generated only once
+     * @param material material of the endgame, 3 or 4 pieces without pawns
+     * @return generated table
+     */
+    const GeneratedTablebase &generate(const Material &material);
+
+
+    /**
+     * @brief Get all generated tables
+     * @return generated tables by material name
+     */
+    const std::map<std::string, GeneratedTablebase> &getTables() const {
+        return tables_;
+    }
+
+
+private:
+    ThreadPool pool_;                                   ///< Workers sharing each pass
+    std::map<std::string, GeneratedTablebase> tables_;  ///< Generated tables by material name
+};
+
+
+#endif //TABLEBASEGENERATOR_H
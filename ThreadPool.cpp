@@ -0,0 +1,88 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+
+/**
+ * @brief Constructor, starts worker threads
+ * @param threadCount number of worker threads, 0 means number of hardware threads
+ */
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+
+/**
+ * @brief Destructor, finishes all submitted tasks and joins worker threads
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskAvailable_.notify_all();
+
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+}
+
+
+/**
+ * @brief Add task to the queue, it will be executed by the first free worker
+ * @param newTask task to execute
+ */
+void ThreadPool::submit(task newTask) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(newTask));
+    }
+    taskAvailable_.notify_one();
+}
+
+
+/**
+ * @brief Block until all submitted tasks are finished
+ */
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasksFinished_.wait(lock, [this] { return tasks_.empty() && runningTasks_ == 0; });
+}
+
+
+/**
+ * @brief Worker loop, executes tasks until pool is destroyed
+ * @param workerIndex index of worker
+ */
+void ThreadPool::work(size_t workerIndex) {
+    while (true) {
+        task currentTask;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskAvailable_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+            // remaining tasks are finished before stopping
+            if (tasks_.empty()) {
+                return;
+            }
+            currentTask = std::move(tasks_.front());
+            tasks_.pop();
+            ++runningTasks_;
+        }
+
+        currentTask(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --runningTasks_;
+            if (tasks_.empty() && runningTasks_ == 0) {
+                tasksFinished_.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Fixed number of worker threads executing submitted tasks.
+ * @details Each task gets index of worker which executes it, so worker can use its own state (e.g. one Chess
+ * instance per thread) without locking.
+ */
+class ThreadPool {
+public:
+    using task = std::function<void(size_t)>;  ///< Task called with index of worker
+
+
+    /**
+     * @brief Constructor, starts worker threads
+     * @param threadCount number of worker threads, 0 means number of hardware threads
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+
+    /**
+     * @brief Destructor, finishes all submitted tasks and joins worker threads
+     */
+    ~ThreadPool();
+
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+
+    /**
+     * @brief Get number of worker threads
+     * @return number of worker threads
+     */
+    size_t size() const {
+        return workers_.size();
+    }
+
+
+    /**
+     * @brief Add task to the queue, it will be executed by the first free worker
+     * @param newTask task to execute
+     */
+    void submit(task newTask);
+
+
+    /**
+     * @brief Block until all submitted tasks are finished
+     */
+    void wait();
+
+
+private:
+    /**
+     * @brief Worker loop, executes tasks until pool is destroyed
+     * @param workerIndex index of worker
+     */
+    void work(size_t workerIndex);
+
+
+    std::vector<std::thread> workers_;         ///< Worker threads
+    std::queue<task> tasks_;                   ///< Tasks waiting for worker
+    std::mutex mutex_;                         ///< Guards tasks_, runningTasks_ and stopping_
+    std::condition_variable taskAvailable_;    ///< Signals new task or stopping
+    std::condition_variable tasksFinished_;    ///< Signals that queue is empty and no task is running
+    size_t runningTasks_ = 0;                  ///< Number of tasks being executed
+    bool stopping_ = false;                    ///< Pool is being destroyed
+};
+
+
+#endif //THREADPOOL_H
@@ -0,0 +1,227 @@
+#include "Trace.h"
+#include "Json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+
+/**
+ * @brief Finished scope
+ */
+struct TraceEvent {
+    const char *name;        ///< Name of phase
+    std::int64_t start;      ///< Start in nanoseconds since tracing was enabled
+    std::int64_t duration;   ///< Duration in nanoseconds
+};
+
+
+/**
+ * @brief Events and profile of one thread, written only by its thread
+ */
+struct ThreadTrace {
+    size_t threadId;                         ///< Order of first recorded scope of thread
+    std::vector<TraceEvent> events;          ///< Ring buffer of the newest events
+    size_t recorded = 0;                     ///< Number of recorded events, the next one is stored at recorded % size
+    std::vector<TraceProfileEntry> profile;  ///< Time of phases, phases are few -> linear search
+};
+
+
+/**
+ * @brief State shared by all threads
+ */
+struct TraceState {
+    std::mutex mutex;                                  ///< Guards threads
+    std::vector<std::shared_ptr<ThreadTrace>> threads; ///< Traces of threads, kept after threads exit
+    size_t capacity = TRACE_CAPACITY;                  ///< Size of ring buffer of each thread
+    std::chrono::steady_clock::time_point epoch;       ///< Time when tracing was enabled
+    std::atomic<size_t> generation{0};                 ///< Incremented by enable, older thread traces are dropped
+};
+
+
+std::atomic<bool> Trace::enabled_{false};
+
+static TraceState state;
+static thread_local std::shared_ptr<ThreadTrace> threadTrace;
+static thread_local size_t threadGeneration = 0;
+static thread_local TraceScope *innermostScope = nullptr;
+
+
+/**
+ * @brief Get trace of calling thread, it is registered on the first use after tracing was enabled
+ * @return trace of calling thread
+ */
+static ThreadTrace &currentThreadTrace() {
+    size_t generation = state.generation.load(std::memory_order_acquire);
+    if (threadTrace == nullptr || threadGeneration != generation) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        threadTrace = std::make_shared<ThreadTrace>();
+        threadTrace->threadId = state.threads.size();
+        threadTrace->events.resize(state.capacity);
+        threadGeneration = generation;
+        state.threads.push_back(threadTrace);
+    }
+    return *threadTrace;
+}
+
+
+/**
+ * @brief Start recording scopes of all threads, events recorded before are discarded
+ * @param capacity number of events kept by ring buffer of each thread, older events are overwritten
+ */
+void Trace::enable(size_t capacity) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.threads.clear();
+    state.capacity = std::max<size_t>(1, capacity);
+    state.epoch = std::chrono::steady_clock::now();
+    state.generation.fetch_add(1, std::memory_order_release);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Stop recording scopes, recorded events are kept for export
+ */
+void Trace::disable() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Get time since tracing was enabled
+ * @return time in nanoseconds
+ */
+std::int64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state.epoch).count();
+}
+
+
+/**
+ * @brief Record finished scope to ring buffer and profile of calling thread
+ * @param name name of phase, has to be string literal
+ * @param start start of scope returned by now()
+ * @param childTime time spent in nested scopes, in nanoseconds
+ * @return duration of scope in nanoseconds
+ */
+std::int64_t Trace::record(const char *name, std::int64_t start, std::int64_t childTime) {
+    std::int64_t duration = now() - start;
+    ThreadTrace &trace = currentThreadTrace();
+    trace.events[trace.recorded++ % trace.events.size()] = {name, start, duration};
+
+    // names are string literals -> the same phase has the same pointer
+    auto entry = std::find_if(trace.profile.begin(), trace.profile.end(), [name](const TraceProfileEntry &e) {
+        return e.name == name;
+    });
+    if (entry == trace.profile.end()) {
+        entry = trace.profile.insert(trace.profile.end(), TraceProfileEntry{name});
+    }
+    ++entry->count;
+    entry->total += duration;
+    entry->self += duration - childTime;
+    return duration;
+}
+
+
+/**
+ * @brief Make scope the innermost scope of calling thread
+ * @param scope started scope
+ * @return the previous innermost scope, nullptr if there is none
+ */
+TraceScope *Trace::enter(TraceScope *scope) {
+    // buffer of new thread is allocated before the scope starts measuring, so its time is not traced
+    currentThreadTrace();
+    TraceScope *parent = innermostScope;
+    innermostScope = scope;
+    return parent;
+}
+
+
+/**
+ * @brief Make parent of finished scope the innermost scope of calling thread
+ * @param parent scope returned by enter
+ */
+void Trace::leave(TraceScope *parent) {
+    innermostScope = parent;
+}
+
+
+/**
+ * @brief Write recorded events in Chrome trace JSON format (chrome://tracing, ui.perfetto.dev), traced threads
+ * have to be idle
+ * @param os stream to write to
+ */
+void Trace::writeChromeTrace(std::ostream &os) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto &trace : state.threads) {
+        os << (first ? "\n" : ",\n")
+           << JsonWriter().add("name", "thread_name").add("ph", "M").add("pid", 1).add("tid", trace->threadId)
+                          .addRaw("args", JsonWriter().add("name", "thread " + std::to_string(trace->threadId)).str())
+                          .str();
+        first = false;
+
+        // complete events ("ph":"X") in microseconds, the oldest kept event first
+        size_t size = trace->events.size();
+        size_t begin = trace->recorded > size ? trace->recorded - size : 0;
+        for (size_t i = begin; i < trace->recorded; ++i) {
+            const TraceEvent &event = trace->events[i % size];
+            os << ",\n{\"name\":" << JsonObject::quote(event.name) << ",\"cat\":\"search\",\"ph\":\"X\",\"ts\":"
+               << std::fixed << std::setprecision(3) << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0
+               << ",\"pid\":1,\"tid\":" << trace->threadId << '}';
+        }
+    }
+    os << "\n]}" << std::endl;
+}
+
+
+/**
+ * @brief Aggregate profiles of all threads, traced threads have to be idle
+ * @return phases sorted by self time, the longest first
+ */
+std::vector<TraceProfileEntry> Trace::profile() {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::vector<TraceProfileEntry> entries;
+
+    for (const auto &trace : state.threads) {
+        for (const TraceProfileEntry &threadEntry : trace->profile) {
+            auto entry = std::find_if(entries.begin(), entries.end(), [&threadEntry](const TraceProfileEntry &e) {
+                return e.name == threadEntry.name;
+            });
+            if (entry == entries.end()) {
+                entry = entries.insert(entries.end(), TraceProfileEntry{threadEntry.name});
+            }
+            entry->count += threadEntry.count;
+            entry->total += threadEntry.total;
+            entry->self += threadEntry.self;
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const TraceProfileEntry &e1, const TraceProfileEntry &e2) {
+        return e1.self > e2.self;
+    });
+    return entries;
+}
+
+
+/**
+ * @brief Print flat profile: phase, count, total and self time in milliseconds and share of self time
+ * @param os stream to print to
+ */
+void Trace::printProfile(std::ostream &os) {
+    std::vector<TraceProfileEntry> entries = profile();
+    std::int64_t selfSum = 0;
+    for (const TraceProfileEntry &entry : entries) {
+        selfSum += entry.self;
+    }
+
+    os << "phase\tcount\ttotal ms\tself ms\tself %\n";
+    for (const TraceProfileEntry &entry : entries) {
+        os << entry.name << '\t' << entry.count << '\t' << std::fixed << std::setprecision(3) << entry.total / 1e6
+           << '\t' << entry.self / 1e6 << '\t' << std::setprecision(1)
+           << (selfSum > 0 ? 100.0 * entry.self / selfSum : 0) << '\n';
+    }
+    os.flush();
+}
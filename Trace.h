@@ -0,0 +1,161 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+static const size_t TRACE_CAPACITY = 1 << 20;  ///< Default number of events kept by ring buffer of each thread
+
+class TraceScope;
+
+
+/**
+ * @brief Aggregated time of one traced phase over all threads
+ */
+struct TraceProfileEntry {
+    const char *name = nullptr;  ///< Name of phase
+    size_t count = 0;            ///< Number of finished scopes
+    std::int64_t total = 0;      ///< Time spent in scopes including nested scopes, in nanoseconds
+    std::int64_t self = 0;       ///< Time spent in scopes without nested scopes, in nanoseconds
+};
+
+
+/**
+ * @brief Lightweight tracing of search phases, enabled at runtime.
+ * @details Each thread records finished scopes to its own ring buffer, so the newest events of each thread are kept
+ * without locking, and adds their time to its own flat profile, which counts all scopes even when ring buffer
+ * overflows. Disabled tracing costs one relaxed load per scope.
+ */
+namespace Trace {
+    extern std::atomic<bool> enabled_;  ///< Scopes are recorded
+
+
+    /**
+     * @brief Start recording scopes of all threads, events recorded before are discarded
+     * @param capacity number of events kept by ring buffer of each thread, older events are overwritten
+     */
+    void enable(size_t capacity = TRACE_CAPACITY);
+
+
+    /**
+     * @brief Stop recording scopes, recorded events are kept for export
+     */
+    void disable();
+
+
+    /**
+     * @brief Check if scopes are recorded
+     * @return true if tracing is enabled
+     */
+    inline bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+     * @brief Get time since tracing was enabled
+     * @return time in nanoseconds
+     */
+    std::int64_t now();
+
+
+    /**
+     * @brief Record finished scope to ring buffer and profile of calling thread
+     * @param name name of phase, has to be string literal
+     * @param start start of scope returned by now()
+     * @param childTime time spent in nested scopes, in nanoseconds
+     * @return duration of scope in nanoseconds
+     */
+    std::int64_t record(const char *name, std::int64_t start, std::int64_t childTime);
+
+
+    /**
+     * @brief Make scope the innermost scope of calling thread
+     * @param scope started scope
+     * @return the previous innermost scope, nullptr if there is none
+     */
+    TraceScope *enter(TraceScope *scope);
+
+
+    /**
+     * @brief Make parent of finished scope the innermost scope of calling thread
+     * @param parent scope returned by enter
+     */
+    void leave(TraceScope *parent);
+
+
+    /**
+     * @brief Write recorded events in Chrome trace JSON format (chrome://tracing, ui.perfetto.dev), traced threads
+     * have to be idle
+     * @param os stream to write to
+     */
+    void writeChromeTrace(std::ostream &os);
+
+
+    /**
+     * @brief Aggregate profiles of all threads, traced threads have to be idle
+     * @return phases sorted by self time, the longest first
+     */
+    std::vector<TraceProfileEntry> profile();
+
+
+    /**
+     * @brief Print flat profile: phase, count, total and self time in milliseconds and share of self time
+     * @param os stream to print to
+     */
+    void printProfile(std::ostream &os = std::cerr);
+}
+
+
+/**
+ * @brief Scope measured from construction to destruction if tracing is enabled
+ */
+class TraceScope {
+private:
+    const char *name_;              ///< Name of phase, string literal
+    std::int64_t start_ = 0;        ///< Start of scope in nanoseconds since tracing was enabled
+    std::int64_t childTime_ = 0;    ///< Time spent in nested scopes in nanoseconds
+    TraceScope *parent_ = nullptr;  ///< Enclosing scope of the same thread, nullptr = outermost scope
+    bool active_ = false;           ///< Tracing was enabled when scope started
+
+public:
+    /**
+     * @brief Constructor, starts measuring
+     * @param name name of phase, has to be string literal
+     */
+    explicit TraceScope(const char *name) : name_(name) {
+        if (Trace::isEnabled()) {
+            active_ = true;
+            parent_ = Trace::enter(this);
+            start_ = Trace::now();
+        }
+    }
+
+
+    /**
+     * @brief Destructor, records scope
+     */
+    ~TraceScope() {
+        if (active_) {
+            std::int64_t duration = Trace::record(name_, start_, childTime_);
+            Trace::leave(parent_);
+            if (parent_ != nullptr) {
+                parent_->childTime_ += duration;
+            }
+        }
+    }
+
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+
+#endif //TRACE_H
@@ -2,6 +2,10 @@
 #define TYPES_H
 
 #include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Enum class for representing colors.
@@ -40,7 +44,7 @@ struct Vector2D {
      * @param x moveX of the vector.
      * @param y moveY of the vector.
      */
-    Vector2D(int x, int y) : moveX(x), moveY(y) {}
+    constexpr Vector2D(int x, int y) : moveX(x), moveY(y) {}
 
 
     /**
@@ -88,7 +92,7 @@ struct Vector2D {
 struct Position {
     int x_; ///< X coordinate of the position
     int y_; ///< Y coordinate of the position
-    PieceType transformTo_; ///< Piece type to transform to
+    PieceType transformTo_ = PieceType::PAWN; ///< Piece type to transform to, PAWN if move is not promotion
 
 
     /**
@@ -198,4 +202,11 @@ struct Position {
     }
 };
 
+using piece_move = std::pair<Position, Position>;
+using piece_moves = std::vector<piece_move>;
+
+// scratch lists of move generation, allocated from arena of Chess during search
+using position_list = std::pmr::vector<Position>;
+using move_list = std::pmr::vector<piece_move>;
+
 #endif //TYPES_H
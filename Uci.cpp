@@ -0,0 +1,274 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "Chess.h"
+
+// UCI front end, supports position, go mate/depth/movetime/infinite, stop and isready, see USAGE.md for more info
+
+
+static const char *const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR";  ///< Starting position
+static const size_t MAX_UCI_DEPTH = 32;  ///< Maximal number of moves searched without depth or mate limit
+
+
+/**
+ * @brief Limits of one search given by go command
+ */
+struct GoLimits {
+    size_t maxDepth = SEARCH_DEPTH;  ///< Maximal number of moves to checkmate
+    size_t moveTime = 0;             ///< Time for search in milliseconds, 0 = unlimited
+    bool infinite = false;           ///< Best move is sent only after stop
+};
+
+
+/**
+ * @brief UCI engine, searches in separate thread so commands are answered while searching.
+ */
+class UciEngine {
+public:
+    /**
+     * @brief Constructor, sets starting position
+     */
+    UciEngine() {
+        chess_.loadFENGame(START_FEN);
+    }
+
+
+    /**
+     * @brief Destructor, stops running search
+     */
+    ~UciEngine() {
+        stopSearch();
+    }
+
+
+    /**
+     * @brief Handle one command
+     * @param line command line
+     * @return false if engine should quit
+     */
+    bool handle(const std::string &line) {
+        std::istringstream tokens(line);
+        std::string command;
+        tokens >> command;
+
+        if (command == "uci") {
+            send("id name checkmate_solver");
+            send("id author checkmate_solver authors");
+            send("uciok");
+        }
+        else if (command == "isready") {
+            send("readyok");
+        }
+        else if (command == "ucinewgame") {
+            stopSearch();
+            setPosition(START_FEN, Color::WHITE, {});
+        }
+        else if (command == "position") {
+            stopSearch();
+            position(tokens);
+        }
+        else if (command == "go") {
+            stopSearch();
+            go(tokens);
+        }
+        else if (command == "stop") {
+            stopSearch();
+        }
+        else if (command == "quit") {
+            return false;
+        }
+        return true;
+    }
+
+
+private:
+    /**
+     * @brief Handle position command: position (startpos | fen <fen>) [moves <move>...]
+     * @param tokens command arguments
+     */
+    void position(std::istringstream &tokens) {
+        std::string token;
+        std::string FENCode = START_FEN;
+        Color colorOnMove = Color::WHITE;
+        std::vector<std::string> moves;
+
+        tokens >> token;
+        if (token == "fen") {
+            // only piece placement and side to move are used, castling rights etc. are skipped
+            std::string side;
+            tokens >> FENCode >> side;
+            colorOnMove = side == "b" ? Color::BLACK : Color::WHITE;
+            while (tokens >> token && token != "moves") {
+            }
+        }
+        else {
+            tokens >> token;
+        }
+
+        while (tokens >> token) {
+            moves.push_back(token);
+        }
+        setPosition(FENCode, colorOnMove, moves);
+    }
+
+
+    /**
+     * @brief Load position and play moves, invalid position is reported and replaced by starting position
+     * @param FENCode piece placement part of FEN
+     * @param colorOnMove color on move in FEN position
+     * @param moves moves in coordinate notation played from FEN position
+     */
+    void setPosition(const std::string &FENCode, Color colorOnMove, const std::vector<std::string> &moves) {
+        try {
+            chess_.clearGame();
+            chess_.loadFENGame(FENCode);
+            colorOnMove_ = colorOnMove;
+
+            for (const std::string &move : moves) {
+                chess_.playMove(move, colorOnMove_);
+                colorOnMove_ = colorOnMove_ == Color::WHITE ? Color::BLACK : Color::WHITE;
+            }
+        }
+        catch (const std::exception &e) {
+            send(std::string("info string ") + e.what());
+            chess_.clearGame();
+            chess_.loadFENGame(START_FEN);
+            colorOnMove_ = Color::WHITE;
+        }
+    }
+
+
+    /**
+     * @brief Handle go command and start search thread
+     * @param tokens command arguments
+     */
+    void go(std::istringstream &tokens) {
+        GoLimits limits;
+        bool hasDepth = false;
+        std::string token;
+
+        // depth is in half-moves, mate in moves, clock parameters are ignored
+        while (tokens >> token) {
+            size_t value = 0;
+            if (token == "infinite") {
+                limits.infinite = true;
+                continue;
+            }
+            else if (!(tokens >> value)) {
+                break;
+            }
+
+            if (token == "mate" || token == "depth") {
+                limits.maxDepth = std::max<size_t>(1, token == "mate" ? value : (value + 1) / 2);
+                hasDepth = true;
+            }
+            else if (token == "movetime") {
+                limits.moveTime = value;
+            }
+        }
+        if (!hasDepth && (limits.infinite || limits.moveTime > 0)) {
+            limits.maxDepth = MAX_UCI_DEPTH;
+        }
+
+        // move time is checked by search itself
+        SearchLimits searchLimits = limits.moveTime > 0 ?
+                                    SearchLimits::timeLimit(std::chrono::milliseconds(limits.moveTime)) :
+                                    SearchLimits();
+        searchLimits.stopFlag = &stop_;
+        chess_.setSearchLimits(searchLimits);
+
+        stop_ = false;
+        searchThread_ = std::thread(&UciEngine::search, this, limits);
+    }
+
+
+    /**
+     * @brief Search with iterative deepening until checkmate is found, depth limit is reached or search is stopped
+     * @param limits limits of search
+     */
+    void search(GoLimits limits) {
+        piece_move bestMove;
+        auto start = std::chrono::steady_clock::now();
+
+        // shortest checkmate is found first
+        for (size_t depth = 1; depth <= limits.maxDepth; ++depth) {
+            SearchResult result = chess_.findCheckMate(colorOnMove_, depth);
+
+            // interrupted search -> best move of unfinished depth is used only if it proved checkmate
+            if (result.status != SearchStatus::COMPLETED && !result) {
+                bestMove = bestMove == piece_move() ? result.bestMove : bestMove;
+                break;
+            }
+            bestMove = result.bestMove;
+
+            std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+            std::ostringstream info;
+            info << "info depth " << 2 * depth
+                 << (result ? " score mate " + std::to_string(result.mateDistance) : "")
+                 << " nodes " << result.stats.nodes << " time " << static_cast<size_t>(time.count()) << " pv";
+            for (const std::string &move : chess_.lineNotation(result.principalVariation)) {
+                info << ' ' << move;
+            }
+            send(info.str());
+            if (result) {
+                break;
+            }
+        }
+
+        // infinite search -> best move is sent after stop command
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopRequested_.wait(lock, [this, &limits] { return !limits.infinite || stop_; });
+        lock.unlock();
+
+        std::string move = chess_.moveNotation(bestMove);
+        send("bestmove " + (move.empty() ? std::string("0000") : move));
+    }
+
+
+    /**
+     * @brief Stop running search and wait until best move is sent
+     */
+    void stopSearch() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        stopRequested_.notify_all();
+
+        if (searchThread_.joinable()) {
+            searchThread_.join();
+        }
+    }
+
+
+    /**
+     * @brief Send line to GUI
+     * @param line line to send
+     */
+    void send(const std::string &line) {
+        std::lock_guard<std::mutex> lock(outputMutex_);
+        std::cout << line << std::endl;
+    }
+
+
+    Chess chess_;                            ///< Searched position
+    Color colorOnMove_ = Color::WHITE;       ///< Color on move in searched position
+    std::thread searchThread_;               ///< Running search
+    std::atomic<bool> stop_ = false;         ///< Stop flag polled by search
+    std::mutex mutex_;                       ///< Guards waiting for stop of infinite search
+    std::condition_variable stopRequested_;  ///< Signals stop command
+    std::mutex outputMutex_;                 ///< Lines are sent by main and search thread
+};
+
+
+int main() {
+    UciEngine engine;
+    std::string line;
+
+    while (std::getline(std::cin, line) && engine.handle(line)) {
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+#include "Types.h"
+
+
+/**
+ * @brief Random keys for Zobrist hashing of positions, position hash is xor of keys of all pieces and side to move.
+ * @details Keys are generated at compile time by splitmix64 with fixed seed, so hashes are the same in every run and
+ * can be stored in files.
+ */
+namespace Zobrist {
+    /**
+     * @brief Keys of pieces and side to move
+     */
+    struct Keys {
+        std::uint64_t pieces[2][6][64];  ///< Key of piece [color][piece type][square 8 * x + y]
+        std::uint64_t blackToMove;       ///< Key added if black is on move
+    };
+
+
+    /**
+     * @brief Generate next pseudo-random number by splitmix64
+     * @param state generator state, it is updated
+     * @return pseudo-random number
+     */
+    constexpr std::uint64_t splitMix64(std::uint64_t &state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+
+    /**
+     * @brief Generate all keys
+     * @return generated keys
+     */
+    constexpr Keys generateKeys() {
+        Keys keys{};
+        std::uint64_t state = 0x436865636B6D6174ULL;
+
+        for (auto &color : keys.pieces) {
+            for (auto &pieceType : color) {
+                for (std::uint64_t &square : pieceType) {
+                    square = splitMix64(state);
+                }
+            }
+        }
+        keys.blackToMove = splitMix64(state);
+        return keys;
+    }
+
+
+    inline constexpr Keys KEYS = generateKeys();  ///< Keys used by Chess::positionHash
+
+
+    /**
+     * @brief Get key of piece on square
+     * @param color color of piece
+     * @param pieceType type of piece
+     * @param x row of square
+     * @param y column of square
+     * @return key of piece
+     */
+    inline std::uint64_t pieceKey(Color color, PieceType pieceType, int x, int y) {
+        return KEYS.pieces[static_cast<int>(color)][static_cast<int>(pieceType)][8 * x + y];
+    }
+}
+
+
+#endif //ZOBRIST_H
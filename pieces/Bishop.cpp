@@ -3,7 +3,7 @@
 /**
  * Vectors representing the possible moves of the Bishop
  */
-const std::vector<Vector2D> Bishop::vectorMoves_ = {
+const std::array<Vector2D, 4> Bishop::vectorMoves_ = {
         Vector2D(1, 1),   // piece_move diagonally up-right
         Vector2D(1, -1),  // piece_move diagonally down-right
         Vector2D(-1, 1),  // piece_move diagonally up-left
@@ -2,35 +2,25 @@
 #define BISHOP_H
 
 #include "Piece.h"
-#include <vector>
+#include <array>
 
 /**
- * @brief Class to represent Bishop on chessboard, extends Piece
+ * @brief Moves of Bishop on chessboard, bishop is sliding piece generated by Piece
  */
-class Bishop final : public Piece {
+class Bishop final {
 private:
     /// Vectors representing the possible bishop moves
-    static const std::vector<Vector2D> vectorMoves_;
-    static const int value_ = 3;
+    static const std::array<Vector2D, 4> vectorMoves_;
 
 public:
-    /**
-     * Constructor
-     * @param color color of Bishop
-     * @param name name of Bishop
-     * @param pieceName used in toString method
-     */
-    explicit Bishop(Color color, const Position &position) : Piece(color, PieceType::BISHOP, value_, vectorMoves_, position) {}
-
-
     /**
      * @brief Get vector of possible moves
      * @return vector of possible moves
      */
-    static const std::vector<Vector2D>& getVectorMoves() {
+    static std::span<const Vector2D> getVectorMoves() {
         return vectorMoves_;
     }
 };
 
 
-#endif //BISHOP_H
\ No newline at end of file
+#endif // BISHOP_H
@@ -4,7 +4,7 @@
 /**
  * Vectors representing the possible moves of the King
  */
-const std::vector<Vector2D> King::vectorMoves_ = {
+const std::array<Vector2D, 8> King::vectorMoves_ = {
         Vector2D(1, 0),   // Move 1 step to the right
         Vector2D(-1, 0),  // Move 1 step to the left
         Vector2D(0, 1),   // Move 1 step forward
@@ -19,16 +19,18 @@ const std::vector<Vector2D> King::vectorMoves_ = {
 /**
  * Get available positions of the piece
  * @param chess chess logic
+ * @param position position of King
+ * @param color color of King
  * @return positions of the piece
  */
-std::vector<Position> King::getPossibleMoves(Chess &chess) const {
-    std::vector<Position> positions;
+position_list King::getPossibleMoves(Chess &chess, const Position &position, Color color) {
+    position_list positions(chess.scratch());
 
     for (const auto &move: vectorMoves_) {
-        Position newPosition = position_ + move;
+        Position newPosition = position + move;
         if (Chess::onChessboard(newPosition) &&
-            (chess.isFree(newPosition) || chess.canCapture(newPosition, color_)) &&
-            !chess.kingsNeighboursOrCheck(newPosition, color_)) {
+            (chess.isFree(newPosition) || chess.canCapture(newPosition, color)) &&
+            !chess.kingsNeighboursOrCheck(newPosition, color)) {
                 positions.push_back(newPosition);
         }
     }
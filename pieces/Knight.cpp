@@ -4,7 +4,7 @@
 /**
  * Vectors representing the possible knight moves
  */
-const std::vector<Vector2D> Knight::vectorMoves_ = {
+const std::array<Vector2D, 8> Knight::vectorMoves_ = {
         Vector2D(2, 1),   // Move 2 steps forward and 1 step to the right
         Vector2D(1, 2),   // Move 1 step forward and 2 steps to the right
         Vector2D(-2, 1),  // Move 2 steps backward and 1 step to the right
@@ -19,12 +19,14 @@ const std::vector<Vector2D> Knight::vectorMoves_ = {
 /**
  * Check if the piece gives check
  * @param chess chess logic
+ * @param position position of Knight
+ * @param color color of Knight
  * @return true if the piece gives check
  */
-bool Knight::givesCheck(const Chess &chess) const {
+bool Knight::givesCheck(const Chess &chess, const Position &position, Color color) {
     for (const auto &move: vectorMoves_) {
-        Position newPosition = position_ + move;
-        if (Chess::onChessboard(newPosition) && chess.isEnemyKing(newPosition, color_)) {
+        Position newPosition = position + move;
+        if (Chess::onChessboard(newPosition) && chess.isEnemyKing(newPosition, color)) {
             return true;
         }
     }
@@ -35,22 +37,24 @@ bool Knight::givesCheck(const Chess &chess) const {
 /**
  * Get available moves of the piece
  * @param chess chess logic
+ * @param position position of Knight
+ * @param color color of Knight
  * @return moves of the piece
  */
-std::vector<Position> Knight::getPossibleMoves(Chess &chess) const {
-    std::vector<Position> positions;
+position_list Knight::getPossibleMoves(Chess &chess, const Position &position, Color color) {
+    position_list positions(chess.scratch());
     Position newPosition;
 
     // if knight is blocking check, it can't updatePosition
-    if (chess.pieceBlocksCheck(position_, color_, positions)) {
+    if (chess.pieceBlocksCheck(position, color, positions)) {
         return {};
     }
     positions.clear();
 
     for (const auto &move: vectorMoves_) {
-        newPosition = position_ + move;
+        newPosition = position + move;
         if (Chess::onChessboard(newPosition) &&
-            (chess.isFree(newPosition) || chess.canCapture(newPosition, color_))) {
+            (chess.isFree(newPosition) || chess.canCapture(newPosition, color))) {
                 positions.push_back(newPosition);
         }
     }
@@ -2,55 +2,42 @@
 #define KNIGHT_H
 
 #include "Piece.h"
-#include <vector>
+#include <array>
 
 /**
- * @brief Class to represent Knight on chessboard, extends Piece
+ * @brief Moves of Knight on chessboard
  */
-class Knight final : public Piece {
+class Knight final {
 private:
     /// Vectors representing the possible knight moves
-    static const std::vector<Vector2D> vectorMoves_;
-    static const int value_ = 3;
+    static const std::array<Vector2D, 8> vectorMoves_;
 
 public:
-    /**
-     * Constructor
-     * @param color color of Knight
-     */
-    explicit Knight(Color color, const Position &position) : Piece(color, PieceType::KNIGHT, value_, vectorMoves_, position) {}
-
-
-    /**
-     * Check if the piece check can be blocked by another piece
-     * @return true if the piece check can be blocked by another piece
-     */
-    bool isCheckBlockAble() const override {
-        return false;
-    }
-
-
     /**
      * Check if the piece gives check
      * @param chess chess logic
+     * @param position position of Knight
+     * @param color color of Knight
      * @return true if the piece gives check
      */
-    bool givesCheck(const Chess &chess) const override;
+    static bool givesCheck(const Chess &chess, const Position &position, Color color);
 
 
     /**
      * Get available moves of the piece
      * @param chess chess logic
+     * @param position position of Knight
+     * @param color color of Knight
      * @return moves of the piece
      */
-    std::vector<Position> getPossibleMoves(Chess &chess) const override;
+    static position_list getPossibleMoves(Chess &chess, const Position &position, Color color);
 
 
     /**
      * @brief Get vector of possible moves
      * @return vector of possible moves
      */
-    static const std::vector<Vector2D>& getVectorMoves() {
+    static std::span<const Vector2D> getVectorMoves() {
         return vectorMoves_;
     }
 };
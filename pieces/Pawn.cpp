@@ -4,13 +4,15 @@
 /**
  * Check if the piece gives check
  * @param chess chess logic
+ * @param position position of Pawn
+ * @param color color of Pawn
  * @return true if the piece gives check
  */
-bool Pawn::givesCheck(const Chess &chess) const {
+bool Pawn::givesCheck(const Chess &chess, const Position &position, Color color) {
     // pawn can give check only diagonally
-    for (Vector2D move : captureMoves_) {
-        Position newPosition = position_ + move;
-        if (Chess::onChessboard(newPosition) && chess.isEnemyKing(newPosition, color_)) {
+    for (Vector2D move : getCaptureMoves(color)) {
+        Position newPosition = position + move;
+        if (Chess::onChessboard(newPosition) && chess.isEnemyKing(newPosition, color)) {
             return true;
         }
     }
@@ -21,36 +23,42 @@ bool Pawn::givesCheck(const Chess &chess) const {
 /**
  * Get available moves of the piece
  * @param chess chess logic
+ * @param position position of Pawn
+ * @param color color of Pawn
  * @return moves of the piece
  */
-std::vector<Position> Pawn::getPossibleMoves(Chess &chess) const {
-    std::vector<Position> positions;
+position_list Pawn::getPossibleMoves(Chess &chess, const Position &position, Color color) {
+    position_list positions(chess.scratch());
 
     // if piece blocks check
-    if (chess.pieceBlocksCheck(position_, color_, positions)) {
-        return pawnBlocksCheckMoves(chess, positions);
+    if (chess.pieceBlocksCheck(position, color, positions)) {
+        return pawnBlocksCheckMoves(chess, position, color, positions);
     }
     positions.clear();
 
-    checkRegularMoves(chess, positions);
-    checkCaptureMoves(chess, positions);
+    checkRegularMoves(chess, position, color, positions);
+    checkCaptureMoves(chess, position, color, positions);
     return positions;
 }
 
 /**
  * Get available moves of the piece when it blocks check
  * @param chess chess logic
+ * @param position position of Pawn
+ * @param color color of Pawn
+ * @param chessBlocking vector of positions that block check
  * @return moves of the piece
  */
-std::vector<Position> Pawn::pawnBlocksCheckMoves(Chess &chess, const std::vector<Position> &chessBlocking) const {
-    std::vector<Position> reachable;
-    std::vector<Position> reachableChessBlocking;
-    checkRegularMoves(chess, reachable);
-    checkCaptureMoves(chess, reachable);
-
-    for (const auto &position : reachable) {
-        if (std::find(chessBlocking.begin(), chessBlocking.end(), position) != reachable.end()) {
-            reachableChessBlocking.push_back(position);
+position_list Pawn::pawnBlocksCheckMoves(Chess &chess, const Position &position, Color color,
+                                         const position_list &chessBlocking) {
+    position_list reachable(chess.scratch());
+    position_list reachableChessBlocking(chess.scratch());
+    checkRegularMoves(chess, position, color, reachable);
+    checkCaptureMoves(chess, position, color, reachable);
+
+    for (const auto &newPosition : reachable) {
+        if (std::find(chessBlocking.begin(), chessBlocking.end(), newPosition) != chessBlocking.end()) {
+            reachableChessBlocking.push_back(newPosition);
         }
     }
     return reachableChessBlocking;
@@ -62,7 +70,7 @@ std::vector<Position> Pawn::pawnBlocksCheckMoves(Chess &chess, const std::vector
  * @param position position of the piece
  * @param positions vector of positions
  */
-void Pawn::checkTransformation(Position &position, std::vector<Position> &positions) const {
+void Pawn::checkTransformation(Position &position, position_list &positions) {
     if (position.x_ == 0 || position.x_ == 7) {
         position.setTransformation(PieceType::QUEEN);
 
@@ -77,18 +85,23 @@ void Pawn::checkTransformation(Position &position, std::vector<Position> &positi
 /**
  * @brief Check if pawn can updatePosition forward, if yes, add reachable positions to positions
  * @param chess chess logic
+ * @param position position of Pawn
+ * @param color color of Pawn
  * @param positions positions
  */
-void Pawn::checkRegularMoves(Chess &chess, std::vector<Position> &positions) const {
+void Pawn::checkRegularMoves(Chess &chess, const Position &position, Color color, position_list &positions) {
+    std::span<const Vector2D> regularMoves = getRegularMoves(color);
+    int startingRow = (color == Color::WHITE) ? PawnWhite::startingRow_ : PawnBlack::startingRow_;
+
     // check regular updatePosition forward by 1
-    Position newPosition = position_ + regularMoves_[0];
+    Position newPosition = position + regularMoves[0];
     if (chess.isFree(newPosition)) {
         checkTransformation(newPosition, positions);
         positions.emplace_back(newPosition);
 
         // check regular updatePosition forward by 2
-        newPosition = position_ + regularMoves_[1];
-        if (position_.x_ == startingRow_ && chess.isFree(newPosition)) {
+        newPosition = position + regularMoves[1];
+        if (position.x_ == startingRow && chess.isFree(newPosition)) {
             positions.emplace_back(newPosition);
         }
     }
@@ -98,15 +111,17 @@ void Pawn::checkRegularMoves(Chess &chess, std::vector<Position> &positions) con
 /**
  * @brief Check if pawn can capture enemy, if yes, add reachable positions to positions
  * @param chess chess logic
+ * @param position position of Pawn
+ * @param color color of Pawn
  * @param positions positions
  */
-void Pawn::checkCaptureMoves(Chess &chess, std::vector<Position> &positions) const {
+void Pawn::checkCaptureMoves(Chess &chess, const Position &position, Color color, position_list &positions) {
     Position newPosition;
 
-    for (Vector2D move : captureMoves_) {
-        newPosition = position_ + move;
+    for (Vector2D move : getCaptureMoves(color)) {
+        newPosition = position + move;
         if (Chess::onChessboard(newPosition) && !chess.isFree(newPosition) &&
-            chess.canCapture(newPosition, color_)) {
+            chess.canCapture(newPosition, color)) {
             checkTransformation(newPosition, positions);
             positions.emplace_back(newPosition);
         }
@@ -2,64 +2,65 @@
 #define PAWN_H
 
 #include "Piece.h"
-#include <vector>
+#include "PawnWhite.h"
+#include "PawnBlack.h"
 
 
 /**
- * @brief Class to represent Pawn on chessboard, extends Piece
+ * @brief Moves of Pawn on chessboard, directions depend on color (PawnWhite, PawnBlack)
  */
-class Pawn : public Piece {
-private:
-    /// Vectors representing the possible pawn moves
-    const std::vector<Vector2D> regularMoves_;
-    const std::vector<Vector2D> captureMoves_;
-
-    const int startingRow_;
-    const static int value_ = 1;
-
+class Pawn final {
 public:
     /**
-     * Constructor
+     * @brief Get vector of regular moves
      * @param color color of Pawn
+     * @return vector of regular moves
      */
-    explicit Pawn(Color color, const std::vector<Vector2D> &regularMoves, const std::vector<Vector2D> &captureMoves,
-                  int startingRow, const Position &position) :
-                  Piece(color, PieceType::PAWN, value_, regularMoves, position), regularMoves_(regularMoves),
-                  captureMoves_(captureMoves), startingRow_(startingRow) {}
+    static std::span<const Vector2D> getRegularMoves(Color color) {
+        return color == Color::WHITE ? PawnWhite::getRegularMoves() : PawnBlack::getRegularMoves();
+    }
 
 
     /**
-     * Check if the piece check can be blocked by another piece
-     * @return true if the piece check can be blocked by another piece
+     * @brief Get vector of capture moves
+     * @param color color of Pawn
+     * @return vector of capture moves
      */
-    bool isCheckBlockAble() const override {
-        return false;
+    static std::span<const Vector2D> getCaptureMoves(Color color) {
+        return color == Color::WHITE ? PawnWhite::getCaptureMoves() : PawnBlack::getCaptureMoves();
     }
 
 
     /**
      * Check if the piece gives check
      * @param chess chess logic
+     * @param position position of Pawn
+     * @param color color of Pawn
      * @return true if the piece gives check
      */
-    bool givesCheck(const Chess &chess) const override;
+    static bool givesCheck(const Chess &chess, const Position &position, Color color);
 
 
     /**
      * Get available moves of the piece
      * @param chess chess logic
+     * @param position position of Pawn
+     * @param color color of Pawn
      * @return moves of the piece
      */
-    std::vector<Position> getPossibleMoves(Chess &chess) const override;
+    static position_list getPossibleMoves(Chess &chess, const Position &position, Color color);
 
 
     /**
      * Get available moves of the piece when it blocks check
      * @param chess chess logic
+     * @param position position of Pawn
+     * @param color color of Pawn
      * @param chessBlocking vector of positions that block check
      * @return moves at chess-blocking positions
      */
-    std::vector<Position> pawnBlocksCheckMoves(Chess &chess, const std::vector<Position> &chessBlocking) const;
+    static position_list pawnBlocksCheckMoves(Chess &chess, const Position &position, Color color,
+                                              const position_list &chessBlocking);
 
 
     /**
@@ -67,23 +68,27 @@ public:
      * @param position position of the piece
      * @param positions vector of positions
      */
-    void checkTransformation(Position &position, std::vector<Position> &positions) const;
+    static void checkTransformation(Position &position, position_list &positions);
 
 
     /**
      * @brief Check if pawn can updatePosition forward, if yes, add reachable positions to positions
      * @param chess chess logic
+     * @param position position of Pawn
+     * @param color color of Pawn
      * @param positions positions
      */
-    void checkRegularMoves(Chess &chess, std::vector<Position> &positions) const;
+    static void checkRegularMoves(Chess &chess, const Position &position, Color color, position_list &positions);
 
 
     /**
      * @brief Check if pawn can capture enemy, if yes, add reachable positions to positions
      * @param chess chess logic
+     * @param position position of Pawn
+     * @param color color of Pawn
      * @param positions positions
      */
-    void checkCaptureMoves(Chess &chess, std::vector<Position> &positions) const;
+    static void checkCaptureMoves(Chess &chess, const Position &position, Color color, position_list &positions);
 };
 
 #endif //PAWN_H
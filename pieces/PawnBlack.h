@@ -1,30 +1,27 @@
 #ifndef PAWNBLACK_H
 #define PAWNBLACK_H
 
-#include "Pawn.h"
+#include "Piece.h"
+#include <array>
 
 /**
- * @brief Class to represent Black Pawn on chessboard, extends Pawn
+ * @brief Moves of Black Pawn on chessboard
  */
-class PawnBlack final : public Pawn {
+class PawnBlack final {
 private:
     /// Vectors representing the possible black pawn moves
-    static const std::vector<Vector2D> regularMoves_;
-    static const std::vector<Vector2D> captureMoves_;
-    static const int startingRow_ = 1;
+    static const std::array<Vector2D, 2> regularMoves_;
+    static const std::array<Vector2D, 2> captureMoves_;
 
 public:
-    /**
-     * Constructor
-     */
-    PawnBlack(const Position &position) : Pawn(Color::BLACK, regularMoves_, captureMoves_, startingRow_, position) {}
+    static const int startingRow_ = 1;  ///< Row from which pawn can move forward by 2
 
 
     /**
      * @brief Get vector of regular moves
      * @return vector of regular moves
      */
-    static const std::vector<Vector2D>& getRegularMoves() {
+    static std::span<const Vector2D> getRegularMoves() {
         return regularMoves_;
     }
 
@@ -33,9 +30,9 @@ public:
      * @brief Get vector of capture moves
      * @return vector of capture moves
      */
-    static const std::vector<Vector2D>& getCaptureMoves() {
+    static std::span<const Vector2D> getCaptureMoves() {
         return captureMoves_;
     }
 };
 
-#endif // PAWNBLACK_H
\ No newline at end of file
+#endif // PAWNBLACK_H
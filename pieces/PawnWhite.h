@@ -1,31 +1,28 @@
 #ifndef PAWNWHITE_H
 #define PAWNWHITE_H
 
-#include "Pawn.h"
+#include "Piece.h"
+#include <array>
 
 /**
- * @brief Class to represent White Pawn on chessboard, extends Pawn
+ * @brief Moves of White Pawn on chessboard
  */
-class PawnWhite final : public Pawn {
+class PawnWhite final {
 private:
     /// Vectors representing the possible white pawn moves
-    static const std::vector<Vector2D> regularMoves_;
-    static const std::vector<Vector2D> captureMoves_;
-    static const int startingRow_ = 6;
+    static const std::array<Vector2D, 2> regularMoves_;
+    static const std::array<Vector2D, 2> captureMoves_;
 
 public:
-    /**
-     * Constructor
-     */
-    PawnWhite(const Position &position) : Pawn(Color::WHITE, regularMoves_, captureMoves_, startingRow_, position) {}
+    static const int startingRow_ = 6;  ///< Row from which pawn can move forward by 2
 
 
     /**
      * @brief Get vector of regular moves
      * @return vector of regular moves
      */
-    static const std::vector<Vector2D>& getCaptureMoves() {
-        return captureMoves_;
+    static std::span<const Vector2D> getRegularMoves() {
+        return regularMoves_;
     }
 
 
@@ -33,12 +30,9 @@ public:
      * @brief Get vector of capture moves
      * @return vector of capture moves
      */
-    static const std::vector<Vector2D>& getRegularMoves() {
-        return regularMoves_;
+    static std::span<const Vector2D> getCaptureMoves() {
+        return captureMoves_;
     }
 };
 
-
-
-
-#endif // PAWNWHITE_H
\ No newline at end of file
+#endif // PAWNWHITE_H
@@ -1,15 +1,95 @@
 #include "Piece.h"
+#include "Bishop.h"
+#include "King.h"
+#include "Knight.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
 #include "../Chess.h"
 
 
+/**
+ * @brief Get moves of piece
+ * @return move vectors of piece type, regular moves for pawn
+ */
+std::span<const Vector2D> Piece::getVectorMoves() const {
+    switch (getPieceType()) {
+        case PieceType::PAWN:
+            return Pawn::getRegularMoves(getColor());
+        case PieceType::BISHOP:
+            return Bishop::getVectorMoves();
+        case PieceType::KNIGHT:
+            return Knight::getVectorMoves();
+        case PieceType::ROOK:
+            return Rook::getVectorMoves();
+        case PieceType::QUEEN:
+            return Queen::getVectorMoves();
+        default:
+            return King::getVectorMoves();
+    }
+}
+
+
 /**
  * @brief Check if the piece gives check
  * @param chess chess logic
+ * @param position position of the piece
+ * @return true if the piece gives check
+ */
+bool Piece::givesCheck(const Chess &chess, const Position &position) const {
+    switch (getPieceType()) {
+        case PieceType::PAWN:
+            return Pawn::givesCheck(chess, position, getColor());
+        case PieceType::BISHOP:
+            return slidingGivesCheck(chess, position, getColor(), Bishop::getVectorMoves());
+        case PieceType::KNIGHT:
+            return Knight::givesCheck(chess, position, getColor());
+        case PieceType::ROOK:
+            return slidingGivesCheck(chess, position, getColor(), Rook::getVectorMoves());
+        case PieceType::QUEEN:
+            return slidingGivesCheck(chess, position, getColor(), Queen::getVectorMoves());
+        default:
+            return false;
+    }
+}
+
+
+/**
+ * @brief Get available positions of the piece
+ * @param chess chess logic
+ * @param position position of the piece
+ * @return positions of the piece
+ */
+position_list Piece::getPossibleMoves(Chess &chess, const Position &position) const {
+    switch (getPieceType()) {
+        case PieceType::PAWN:
+            return Pawn::getPossibleMoves(chess, position, getColor());
+        case PieceType::BISHOP:
+            return slidingMoves(chess, position, getColor(), Bishop::getVectorMoves());
+        case PieceType::KNIGHT:
+            return Knight::getPossibleMoves(chess, position, getColor());
+        case PieceType::ROOK:
+            return slidingMoves(chess, position, getColor(), Rook::getVectorMoves());
+        case PieceType::QUEEN:
+            return slidingMoves(chess, position, getColor(), Queen::getVectorMoves());
+        default:
+            return King::getPossibleMoves(chess, position, getColor());
+    }
+}
+
+
+/**
+ * @brief Check if sliding piece gives check
+ * @param chess chess logic
+ * @param position position of the piece
+ * @param color color of the piece
+ * @param vectorMoves directions of the piece
  * @return true if the piece gives check
  */
-bool Piece::givesCheck(const Chess &chess) const {
+bool Piece::slidingGivesCheck(const Chess &chess, const Position &position, Color color,
+                              std::span<const Vector2D> vectorMoves) {
     // get vector in which piece_move is located enemy king
-    Vector2D vector = chess.enemyKingPosition(color_) - position_;
+    Vector2D vector = chess.enemyKingPosition(color) - position;
 
     // end if the vector cannot be in the direction of the enemy king
     if (!vector.couldBlockCheck()) {
@@ -18,36 +98,45 @@ bool Piece::givesCheck(const Chess &chess) const {
     vector.normalize();
 
     // end if the vector is not in the list of possible moves
-    if (std::find(vectorMoves_.begin(), vectorMoves_.end(), vector) == vectorMoves_.end()) {
+    if (std::find(vectorMoves.begin(), vectorMoves.end(), vector) == vectorMoves.end()) {
         return false;
     }
 
     // while there is no piece on the way keep moving
-    Position newPosition = position_ + vector;
+    Position newPosition = position + vector;
     while (chess.isFree(newPosition)) {
         newPosition += vector;
     }
-    return newPosition == chess.enemyKingPosition(color_);
+    return newPosition == chess.enemyKingPosition(color);
 }
 
 
 /**
- * @brief Get positions on which the piece can move
+ * @brief Get available positions of sliding piece
  * @param chess chess logic
+ * @param position position of the piece
+ * @param color color of the piece
+ * @param vectorMoves directions of the piece
  * @return positions of the piece
  */
-std::vector<Position> Piece::getPossibleMoves(Chess &chess) const {
-    std::vector<Position> positions;
+position_list Piece::slidingMoves(Chess &chess, const Position &position, Color color,
+                                  std::span<const Vector2D> vectorMoves) {
+    position_list positions(chess.scratch());
     Position newPosition;
 
-    // if piece blocks check
-    if (chess.pieceBlocksCheck(position_, color_, positions)) {
+    // if piece blocks check -> it can move only along the line between king and checking piece
+    if (chess.pieceBlocksCheck(position, color, positions)) {
+        Vector2D vector = position - chess.myKingPosition(color);
+        vector.normalize();
+        if (std::find(vectorMoves.begin(), vectorMoves.end(), vector) == vectorMoves.end()) {
+            positions.clear();
+        }
         return positions;
     }
     positions.clear();
 
-    for (const Vector2D& move : vectorMoves_) {
-        newPosition = position_ + move;
+    for (const Vector2D& move : vectorMoves) {
+        newPosition = position + move;
 
         // while there is no piece on the way
         while (Chess::onChessboard(newPosition) && chess.isFree(newPosition)) {
@@ -56,7 +145,7 @@ std::vector<Position> Piece::getPossibleMoves(Chess &chess) const {
         }
 
         // if there is a piece on the way, and it is an enemy piece
-        if (Chess::onChessboard(newPosition) && chess.canCapture(newPosition, color_)) {
+        if (Chess::onChessboard(newPosition) && chess.canCapture(newPosition, color)) {
             positions.push_back(newPosition);
         }
     }
@@ -67,12 +156,13 @@ std::vector<Position> Piece::getPossibleMoves(Chess &chess) const {
 /**
  * @brief printBoard piece to output stream
  * @param os output stream
+ * @param position position of the piece
  */
-void Piece::print(std::ostream &os) const {
-    os << position_;
-    os << (color_ == Color::WHITE ? " white " : " black ");
+void Piece::print(std::ostream &os, const Position &position) const {
+    os << position;
+    os << (getColor() == Color::WHITE ? " white " : " black ");
 
-    switch (pieceType_) {
+    switch (getPieceType()) {
         case PieceType::PAWN:
             os << "pawn";
             break;
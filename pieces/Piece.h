@@ -2,41 +2,56 @@
 #define PIECE_H
 
 #include <algorithm>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 #include <iostream>
-#include <memory>
 #include "../Types.h"
 
 /// forward declaration
 class Chess;
 
+/// Value of each piece type indexed by PieceType (value of the King is not important)
+static constexpr int PIECE_VALUES[] = {1, 3, 3, 5, 9, 1};
+
+
 /**
- * @brief class to represent pieces on the chessboard
+ * @brief Piece on the chessboard stored by value in one byte, empty square is Piece()
+ * @details Position of piece is its square on the board. Moves are generated by static functions of piece types
+ * (King, Knight, Pawn and sliding pieces), they are dispatched by switch on piece type.
  */
 class Piece {
-protected:
-    const Color color_;                         ///< Color of the piece
-    const PieceType pieceType_;                 ///< Type of the piece
-    int value_;                                 ///< value of the piece
-    const std::vector<Vector2D> vectorMoves_;   ///< Vector of possible moves
-    Position position_;                         ///< position of the piece
+private:
+    static const std::uint8_t TYPE_MASK = 7;  ///< Bits of piece type + 1
+    static const std::uint8_t BLACK_BIT = 8;  ///< Bit of black piece
+
+    std::uint8_t code_ = 0;  ///< 0 for empty square, piece type + 1 otherwise, BLACK_BIT is set for black piece
 
 public:
+    /**
+     * @brief Constructor of empty square
+     */
+    constexpr Piece() = default;
+
+
     /**
      * @brief Constructor
      * @param color color of Piece
      * @param pieceType type of Piece
      */
-    Piece(Color color, PieceType pieceType, int value, const std::vector<Vector2D> &moves, const Position &position) :
-            color_(color), pieceType_(pieceType), value_(value), vectorMoves_(moves), position_(position) {}
+    constexpr Piece(Color color, PieceType pieceType) :
+            code_(static_cast<std::uint8_t>((static_cast<int>(pieceType) + 1) | (color == Color::BLACK ? BLACK_BIT : 0))) {}
 
 
     /**
-     * @brief Destructor
+     * @brief Check if there is no piece
+     * @return true for empty square
      */
-    ~Piece() = default;
+    bool isEmpty() const {
+        return code_ == 0;
+    }
 
 
     /**
@@ -44,7 +59,7 @@ public:
      * @return color of piece
      */
     Color getColor() const {
-        return color_;
+        return (code_ & BLACK_BIT) ? Color::BLACK : Color::WHITE;
     }
 
 
@@ -53,99 +68,105 @@ public:
      * @return type of piece
      */
     PieceType getPieceType() const {
-        return pieceType_;
-    }
-
-
-    /**
-     * @brief Get moves of piece
-     * @return moves of piece
-     */
-    const std::vector<Vector2D>& getVectorMoves() const {
-        return vectorMoves_;
+        return static_cast<PieceType>((code_ & TYPE_MASK) - 1);
     }
 
 
-    /**
-     * @brief Get position of piece
-     * @return position of piece
-     */
-    const Position &getPosition() const {
-        return position_;
-    }
-
     /**
      * @brief Get value of piece
      * @return value of piece
      */
     int getValue() const {
-        return value_;
+        return PIECE_VALUES[(code_ & TYPE_MASK) - 1];
     }
 
 
     /**
      * @brief Check if the piece check can be blocked by another piece
-     * @return true if the piece check can be blocked by another piece
+     * @return true if the piece check can be blocked by another piece (queen, rook, bishop)
      */
-    virtual bool isCheckBlockAble() const {
-        return true;
+    bool isCheckBlockAble() const {
+        PieceType pieceType = getPieceType();
+        return pieceType == PieceType::BISHOP || pieceType == PieceType::ROOK || pieceType == PieceType::QUEEN;
     }
 
 
+    /**
+     * @brief Get moves of piece
+     * @return move vectors of piece type, regular moves for pawn
+     */
+    std::span<const Vector2D> getVectorMoves() const;
+
+
     /**
      * @brief Check if the piece can updatePosition in the given direction
      * @param vector vector representing the direction
      * @return true if the piece can updatePosition in the given direction
      */
     bool canMoveDirection(const Vector2D &vector) const {
-        return std::any_of(vectorMoves_.begin(), vectorMoves_.end(),
-                           [&vector](const Vector2D& v) { return v == vector; });
+        std::span<const Vector2D> vectorMoves = getVectorMoves();
+        return std::find(vectorMoves.begin(), vectorMoves.end(), vector) != vectorMoves.end();
     }
 
 
-
-
     /**
      * @brief Check if the piece gives check
      * @param chess chess logic
+     * @param position position of the piece
      * @return true if the piece gives check
      */
-    virtual bool givesCheck(const Chess &chess) const;
+    bool givesCheck(const Chess &chess, const Position &position) const;
 
 
     /**
      * @brief Get available positions of the piece
      * @param chess chess logic
+     * @param position position of the piece
      * @return positions of the piece
      */
-    virtual std::vector<Position> getPossibleMoves(Chess &chess) const;
+    position_list getPossibleMoves(Chess &chess, const Position &position) const;
 
 
     /**
-     * @brief printBoard piece to output stream
-     * @param os output stream
+     * @brief Check if sliding piece gives check
+     * @param chess chess logic
+     * @param position position of the piece
+     * @param color color of the piece
+     * @param vectorMoves directions of the piece
+     * @return true if the piece gives check
      */
-    void print(std::ostream& os = std::cout) const;
+    static bool slidingGivesCheck(const Chess &chess, const Position &position, Color color,
+                                  std::span<const Vector2D> vectorMoves);
 
 
     /**
-     * @brief Overload operator<< to print piece
+     * @brief Get available positions of sliding piece
+     * @param chess chess logic
+     * @param position position of the piece
+     * @param color color of the piece
+     * @param vectorMoves directions of the piece
+     * @return positions of the piece
+     */
+    static position_list slidingMoves(Chess &chess, const Position &position, Color color,
+                                      std::span<const Vector2D> vectorMoves);
+
+
+    /**
+     * @brief printBoard piece to output stream
      * @param os output stream
-     * @return output stream with printed piece
+     * @param position position of the piece
      */
-    friend std::ostream& operator<<(std::ostream& os, const Piece& piece) {
-        piece.print(os);
-        return os;
-    }
+    void print(std::ostream &os, const Position &position) const;
 
 
     /**
-     * @brief Update position of piece
-     * @param position new position
+     * @brief Equality operator, pieces are equal if they have the same type and color
+     * @param other piece to compare with
+     * @return true if pieces are equal
      */
-    void updatePosition(const Position &position) {
-        position_ = position;
-    }
+    bool operator==(const Piece &other) const = default;
 };
 
+static_assert(sizeof(Piece) == 1, "piece has to fit to one byte");
+
 #endif // PIECE_H
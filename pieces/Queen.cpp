@@ -3,7 +3,7 @@
 /**
  * @brief Vectors representing the possible moves of the Queen
  */
-const std::vector<Vector2D> Queen::vectorMoves_ = {
+const std::array<Vector2D, 8> Queen::vectorMoves_ = {
         Vector2D(1, 0),   // piece_move right
         Vector2D(-1, 0),  // piece_move left
         Vector2D(0, 1),   // piece_move up
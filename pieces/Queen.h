@@ -2,30 +2,22 @@
 #define QUEEN_H
 
 #include "Piece.h"
-#include <vector>
+#include <array>
 
 /**
- * @brief Class to represent Queen on chessboard, extends Piece
+ * @brief Moves of Queen on chessboard, queen is sliding piece generated by Piece
  */
-class Queen final : public Piece {
+class Queen final {
 private:
     /// Vectors representing the possible queen moves
-    static const std::vector<Vector2D> vectorMoves_;
-    const static int value_ = 9;
+    static const std::array<Vector2D, 8> vectorMoves_;
 
 public:
-    /**
-     * Constructor
-     * @param color color of Queen
-     */
-    explicit Queen(Color color, Position position) : Piece(color, PieceType::QUEEN, value_, vectorMoves_, position) {}
-
-
     /**
      * @brief Get vector of possible moves
      * @return vector of possible moves
      */
-    static const std::vector<Vector2D>& getVectorMoves() {
+    static std::span<const Vector2D> getVectorMoves() {
         return vectorMoves_;
     }
 };
@@ -2,36 +2,25 @@
 #define ROOK_H
 
 #include "Piece.h"
-#include <vector>
-
+#include <array>
 
 /**
- * @brief Class to represent Rook on chessboard, extends Piece
+ * @brief Moves of Rook on chessboard, rook is sliding piece generated by Piece
  */
-class Rook final : public Piece {
+class Rook final {
 private:
     /// Vectors representing the possible rook moves
-    static const std::vector<Vector2D> vectorMoves_;
-    static const int value_ = 5;
+    static const std::array<Vector2D, 4> vectorMoves_;
 
 public:
-    /**
-     * Constructor
-     * @param color color of Rook
-     */
-    explicit Rook(Color color, Position position) : Piece(color, PieceType::ROOK, value_, vectorMoves_, position) {}
-
-
     /**
      * @brief Get vector of possible moves
      * @return vector of possible moves
      */
-    static const std::vector<Vector2D>& getVectorMoves() {
+    static std::span<const Vector2D> getVectorMoves() {
         return vectorMoves_;
     }
 };
 
 
-
-
-#endif //ROOK_H
+#endif // ROOK_H